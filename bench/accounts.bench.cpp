@@ -0,0 +1,251 @@
+#include <eosio/eosio.hpp>
+
+#define private public
+#define apply settings_apply
+#include <seeds.settings.cpp>
+#undef apply
+#include <seeds.accounts.cpp>
+#undef private
+
+#include "bench.hpp"
+
+using namespace eosio;
+
+namespace {
+
+  const uint64_t vouchers_per_account = 20;
+  const uint64_t vouch_points = 2;
+
+  void add_user(accounts & a, name account, name status) {
+    a.users.emplace(contracts::accounts, [&](auto & item) {
+      item.account = account;
+      item.status = status;
+      item.type = "individual"_n;
+    });
+    a.userstatus.emplace(contracts::accounts, [&](auto & item) {
+      item.account = account;
+      item.status = status;
+      item.type = "individual"_n;
+    });
+    a.rep.emplace(contracts::accounts, [&](auto & item) {
+      item.account = account;
+      item.rep = 50;
+      item.rank = 50;
+    });
+  }
+
+  // a sponsor that vouched for n accounts, every account also vouched for by vouchers_per_account others
+  name populate_vouches(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::accounts, &apply);
+    bench::push(contracts::accounts, "reset"_n);
+
+    name sponsor = bench::account(0, 's');
+
+    {
+      accounts a(contracts::accounts, contracts::accounts, datastream<const char*>(nullptr, 0));
+
+      add_user(a, sponsor, "citizen"_n);
+      for (uint64_t v = 0; v < vouchers_per_account; v++) {
+        add_user(a, bench::account(v, 'v'), "citizen"_n);
+      }
+
+      for (uint64_t i = 0; i < n; i++) {
+        name account = bench::account(i);
+        add_user(a, account, "visitor"_n);
+
+        for (uint64_t v = 0; v <= vouchers_per_account; v++) {
+          a.vouches.emplace(contracts::accounts, [&](auto & item) {
+            item.id = a.vouches.available_primary_key();
+            item.sponsor = v == 0 ? sponsor : bench::account(v - 1, 'v');
+            item.account = account;
+            item.vouch_points = vouch_points;
+          });
+        }
+
+        a.vouchtotals.emplace(contracts::accounts, [&](auto & item) {
+          item.account = account;
+          item.total_vouch_points = (vouchers_per_account + 1) * vouch_points;
+          item.total_rep_points = (vouchers_per_account + 1) * vouch_points;
+        });
+      }
+
+      a.size_set("users.sz"_n, n + vouchers_per_account + 1);
+      a.size_set("rep.sz"_n, n + vouchers_per_account + 1);
+    }
+
+    bench::push(contracts::accounts, "initrepbox"_n, uint64_t(0), uint64_t(1000));
+    bench::run_deferred();
+
+    return sponsor;
+  }
+
+  // punishing a sponsor takes the vouch points of all accounts it vouched for
+  void accounts_pnishvouched(bench::state & state) {
+    name sponsor = populate_vouches(state.range());
+
+    state.set_items_processed(state.range());
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "pnishvouched"_n, sponsor, uint64_t(0));
+      bench::run_deferred();
+    }
+  }
+  BENCHMARK(accounts_pnishvouched)->arg(2000);
+
+  void accounts_unvouch(bench::state & state) {
+    name sponsor = populate_vouches(state.range());
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "unvouch"_n, sponsor, bench::account(i++));
+    }
+  }
+  BENCHMARK(accounts_unvouch)->arg(2000);
+
+  // n visitors with rep
+  void populate_users(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::accounts, &apply);
+    bench::push(contracts::accounts, "reset"_n);
+
+    {
+      accounts a(contracts::accounts, contracts::accounts, datastream<const char*>(nullptr, 0));
+      for (uint64_t i = 0; i < n; i++) {
+        add_user(a, bench::account(i), "visitor"_n);
+      }
+      a.size_set("users.sz"_n, n);
+      a.size_set("rep.sz"_n, n);
+    }
+
+    bench::push(contracts::accounts, "initrepbox"_n, uint64_t(0), uint64_t(1000));
+    bench::run_deferred();
+  }
+
+  const uint64_t rep_changes = 200;
+
+  // rep for 100 accounts, two changes each - one addrep action per change
+  void accounts_addrep(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    state.set_iterations(rep_changes);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "addrep"_n, bench::account((i++ % 100) * (n / 100)), uint64_t(1));
+    }
+  }
+  BENCHMARK(accounts_addrep)->range(10000, 100000);
+
+  // the same changes in one addreps action
+  void accounts_addreps(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    std::vector<rep_change> changes;
+    for (uint64_t i = 0; i < rep_changes; i++) {
+      changes.push_back(rep_change{ bench::account((i % 100) * (n / 100)), 1 });
+    }
+
+    state.set_items_processed(rep_changes);
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "addreps"_n, changes);
+    }
+  }
+  BENCHMARK(accounts_addreps)->range(10000, 100000);
+
+
+  // A rep ranking pass over n accounts with an addrep between every two chunks. The pass ranks a locked
+  // snapshot - rep changes wait in repdelta until it is done - so every account is ranked exactly once
+  // even though the changed accounts move up in the byrep index. Checked after the loop.
+  void accounts_rankrep_locked(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    uint64_t changes = 0;
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "rankrep"_n, uint64_t(0), uint64_t(0), uint64_t(500));
+      while (bench::run_deferred(1) > 0) {
+        bench::push(contracts::accounts, "addrep"_n, bench::account((changes * 7919) % n), uint64_t(1));
+        changes++;
+      }
+    }
+    state.set_items_processed(n);
+
+    accounts a(contracts::accounts, contracts::accounts, datastream<const char*>(nullptr, 0));
+
+    auto job = a.jobs.get("rankrep"_n.value);
+    check(job.status == "done"_n && job.processed == n, "rankrep: ranked " + std::to_string(job.processed) + " of " + std::to_string(n));
+    check(a.repdelta.begin() == a.repdelta.end(), "rankrep: rep deltas left after the pass");
+    check(a.get_size(a.rep_lock) == 0, "rankrep: rep still locked");
+
+    // every rank of the snapshot handed out as often as utils::rank hands it out
+    std::vector<uint64_t> expected(100), actual(100);
+    uint64_t total_rep = 0;
+    for (uint64_t i = 0; i < n; i++) {
+      expected[utils::rank(i, n)]++;
+    }
+    for (auto & item : a.rep) {
+      actual[item.rank]++;
+      total_rep += item.rep;
+    }
+    check(actual == expected, "rankrep: ranks are not the ranks of the snapshot");
+    check(total_rep == n * 50 + changes, "rankrep: rep changes lost");
+  }
+  BENCHMARK(accounts_rankrep_locked)->arg(50000);
+
+  // n accounts with cbs, the rank boxes filled
+  void populate_cbs(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::accounts, &apply);
+    bench::push(contracts::accounts, "reset"_n);
+
+    {
+      accounts a(contracts::accounts, contracts::accounts, datastream<const char*>(nullptr, 0));
+      for (uint64_t i = 0; i < n; i++) {
+        name account = bench::account(i);
+        add_user(a, account, "visitor"_n);
+        a.cbs.emplace(contracts::accounts, [&](auto & item) {
+          item.account = account;
+          item.community_building_score = 1 + (i * 7919) % 500;
+          item.rank = 0;
+        });
+      }
+      a.size_set("users.sz"_n, n);
+      a.size_set("cbs.sz"_n, n);
+    }
+
+    bench::push(contracts::accounts, "initcbsbox"_n, uint64_t(0), uint64_t(1000));
+    bench::run_deferred();
+  }
+
+  // cbs changes of referrals - the account is ranked right away
+  void accounts_set_cbs(bench::state & state) {
+    uint64_t n = state.range();
+    populate_cbs(n);
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "testsetcbs"_n, bench::account((i * 7919) % n), uint64_t(1 + i % 1000));
+      i++;
+    }
+  }
+  BENCHMARK(accounts_set_cbs)->range(10000, 100000);
+
+  // a full pass over the cbs table, what the hourly rankcbss did
+  void accounts_rankcbs(bench::state & state) {
+    uint64_t n = state.range();
+    populate_cbs(n);
+
+    state.set_items_processed(n);
+    for (auto _ : state) {
+      bench::push(contracts::accounts, "rankcbs"_n, uint64_t(0), uint64_t(0), uint64_t(200));
+      bench::run_deferred();
+    }
+  }
+  BENCHMARK(accounts_rankcbs)->range(10000, 100000);
+
+}
+
+BENCHMARK_MAIN()
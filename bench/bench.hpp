@@ -0,0 +1,238 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <config_snapshot_table.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * Benchmarks of contract hot paths on the host
+ *
+ * Each benchmark binary compiles one contract (plus settings for the config) against the in-memory
+ * eosio shim in bench/shim. A benchmark fills the tables with the number of rows it is run for,
+ * then times a loop of actions - the same shape as a Google Benchmark function:
+ *
+ *   void harvest_plant(bench::state & state) {
+ *     populate(state.range());          // not timed
+ *     for (auto _ : state) {
+ *       bench::push(contracts::token, "transfer"_n, ...);
+ *     }
+ *   }
+ *   BENCHMARK(harvest_plant)->range(10000, 1000000);
+ *
+ * Everything between the first and the last step of the loop is measured, except what runs between
+ * pause_timing() and resume_timing(). Results are per operation - one loop step unless the benchmark
+ * sets a different number with set_items_processed(): host ns, table row reads and writes, and the
+ * bytes of the rows read and written (serialized size, without the per-row chain overhead).
+ *
+ * Host time is not chain CPU time - the shim has no wasm and no chainbase. Rows and bytes are what
+ * the contract asks of the database and compare one to one between two versions of a contract.
+ *
+ * Usage: <contract>.bench [--filter=<substring>] [--max-rows=<n>]
+ */
+
+namespace bench {
+
+  using eosio::name;
+
+  inline uint64_t & max_rows() {
+    static uint64_t rows = std::numeric_limits<uint64_t>::max();
+    return rows;
+  }
+
+  // contract memory does not outlive an action - neither does the config memo on chain
+  inline void clear_action_memory() {
+    config_snapshot::memo().clear();
+    config_snapshot::float_memo().clear();
+  }
+
+  template <typename... Args>
+  void push(name contract, name action, Args&&... args) {
+    clear_action_memory();
+    eosio::mock::push(contract, action, std::forward<Args>(args)...);
+  }
+
+  // runs deferred transactions (job chunks, scheduled actions) until none are left or max_count ran,
+  // returns how many ran
+  inline uint64_t run_deferred(uint64_t max_count = std::numeric_limits<uint64_t>::max()) {
+    uint64_t count = 0;
+    while (count < max_count) {
+      clear_action_memory();
+      uint64_t ran = eosio::mock::run_deferred(1);
+      if (ran == 0) break;
+      count += ran;
+    }
+    return count;
+  }
+
+  // account names u.....a, u.....b, ... - in the order of the index i
+  inline name account(uint64_t i, char prefix = 'u') {
+    const char * chars = "12345abcdefghijklmnopqrstuvwxyz";
+    std::string s(11, '1');
+    for (int k = 10; k >= 0; k--) {
+      s[k] = chars[i % 31];
+      i /= 31;
+    }
+    return name(std::string(1, prefix) + s);
+  }
+
+  // every benchmark binary compiles the settings contract with its apply renamed to settings_apply
+  extern "C" void settings_apply(uint64_t receiver, uint64_t code, uint64_t action);
+
+  // the config values of settings::reset
+  inline void init_settings() {
+    eosio::mock::register_contract(contracts::settings, &settings_apply);
+    push(contracts::settings, eosio::name("reset"));
+  }
+
+  class state {
+    public:
+      state(int64_t rows) : rows(rows) {}
+
+      int64_t range() const { return rows; }
+
+      void pause_timing() {
+        elapsed += clock::now() - started;
+        auto delta = eosio::mock::db() - db_started;
+        db_total.reads += delta.reads;
+        db_total.writes += delta.writes;
+        db_total.bytes_read += delta.bytes_read;
+        db_total.bytes_written += delta.bytes_written;
+      }
+
+      void resume_timing() {
+        db_started = eosio::mock::db();
+        started = clock::now();
+      }
+
+      void set_items_processed(uint64_t items) { processed = items; }
+
+      void set_iterations(uint64_t n) { iterations = n; }
+
+      struct iterator {
+        state * s;
+        uint64_t remaining;
+        bool operator!=(const iterator & other) const {
+          if (remaining == 0) s->finish();
+          return remaining != 0;
+        }
+        void operator++() { remaining--; }
+        int operator*() const { return 0; }
+      };
+
+      iterator begin() {
+        resume_timing();
+        return iterator{ this, iterations };
+      }
+
+      iterator end() { return iterator{ this, 0 }; }
+
+      void report(const std::string & label) const {
+        uint64_t items = processed > 0 ? processed : iterations;
+        double ops = double(std::max(uint64_t(1), items));
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        printf("%-40s %12.0f %10.1f %10.1f %12.0f %12.0f %10lu\n", label.c_str(),
+          ns / ops, db_total.reads / ops, db_total.writes / ops,
+          db_total.bytes_read / ops, db_total.bytes_written / ops, (unsigned long)items);
+      }
+
+    private:
+      using clock = std::chrono::steady_clock;
+
+      void finish() {
+        if (done) return;
+        done = true;
+        pause_timing();
+      }
+
+      int64_t rows;
+      uint64_t iterations = 1;
+      uint64_t processed = 0;
+      bool done = false;
+      clock::time_point started;
+      clock::duration elapsed = clock::duration::zero();
+      eosio::mock::db_counters db_started;
+      eosio::mock::db_counters db_total;
+  };
+
+  typedef void (*function)(state &);
+
+  struct benchmark {
+    std::string label;
+    function fn;
+    std::vector<int64_t> args;
+
+    benchmark * arg(int64_t rows) {
+      args.push_back(rows);
+      return this;
+    }
+
+    // from, from * 10, ... up to to
+    benchmark * range(int64_t from, int64_t to) {
+      for (int64_t rows = from; rows <= to; rows *= 10) args.push_back(rows);
+      return this;
+    }
+  };
+
+  inline std::deque<benchmark> & registry() {
+    static std::deque<benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  inline benchmark * add(const char * label, function fn) {
+    registry().push_back(benchmark{ label, fn, {} });
+    return &registry().back();
+  }
+
+  inline int run(int argc, char ** argv) {
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+      std::string a = argv[i];
+      if (a.rfind("--filter=", 0) == 0) filter = a.substr(9);
+      else if (a.rfind("--max-rows=", 0) == 0) max_rows() = std::strtoull(a.c_str() + 11, nullptr, 10);
+      else {
+        fprintf(stderr, "usage: %s [--filter=<substring>] [--max-rows=<n>]\n", argv[0]);
+        return 2;
+      }
+    }
+
+    printf("%-40s %12s %10s %10s %12s %12s %10s\n", "benchmark/rows", "ns/op", "reads/op", "writes/op", "bytes rd/op", "bytes wr/op", "ops");
+
+    int failed = 0;
+    for (auto & b : registry()) {
+      if (!filter.empty() && b.label.find(filter) == std::string::npos) continue;
+
+      std::vector<int64_t> args = b.args.empty() ? std::vector<int64_t>{ 0 } : b.args;
+      for (int64_t rows : args) {
+        if (uint64_t(rows) > max_rows()) continue;
+
+        eosio::mock::reset_all();
+        eosio::mock::now_us() = 1600000000ull * 1000000;
+        clear_action_memory();
+
+        std::string label = b.label + "/" + std::to_string(rows);
+        state s(rows);
+        try {
+          b.fn(s);
+          s.report(label);
+        } catch (const std::exception & e) {
+          printf("%-40s FAILED: %s\n", label.c_str(), e.what());
+          failed++;
+        }
+      }
+    }
+    return failed == 0 ? 0 : 1;
+  }
+
+}
+
+// registers the benchmark fn of this binary - returns a bench::benchmark * for arg() and range()
+#define BENCHMARK(fn) static bench::benchmark * bench_##fn = bench::add(#fn, fn)
+
+#define BENCHMARK_MAIN() int main(int argc, char ** argv) { return bench::run(argc, argv); }
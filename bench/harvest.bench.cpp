@@ -0,0 +1,148 @@
+#include <eosio/eosio.hpp>
+
+#define private public
+#define apply settings_apply
+#include <seeds.settings.cpp>
+#undef apply
+#include <seeds.harvest.cpp>
+#undef private
+
+#include "bench.hpp"
+
+using namespace eosio;
+
+namespace {
+
+  const symbol seeds_symbol = symbol("SEEDS", 4);
+
+  // rows in random order of size - i * prime mod n spreads the ranks over the users
+  uint64_t spread(uint64_t i, uint64_t n) {
+    return (i * 7919) % n;
+  }
+
+  // n citizens that planted, with rep, cbs and tx ranks and a bioregion each - planting goes through
+  // the harvest contract so the planted rank boxes are filled like on chain
+  void populate_users(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::harvest, &apply);
+    bench::push(contracts::harvest, "reset"_n);
+
+    harvest::user_tables users(contracts::accounts, contracts::accounts.value);
+    harvest::userstatus_tables userstatus(contracts::accounts, contracts::accounts.value);
+    harvest::rep_tables rep(contracts::accounts, contracts::accounts.value);
+    harvest::cbs_tables cbs(contracts::accounts, contracts::accounts.value);
+    harvest::tx_points_tables txpoints(contracts::harvest, contracts::harvest.value);
+    harvest::members_tables members(contracts::bioregion, contracts::bioregion.value);
+
+    for (uint64_t i = 0; i < n; i++) {
+      name account = bench::account(i);
+      uint64_t r = spread(i, n);
+
+      users.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.status = "citizen"_n;
+        item.type = "individual"_n;
+      });
+      userstatus.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.status = "citizen"_n;
+        item.type = "individual"_n;
+      });
+      rep.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.rep = 1 + r % 1000;
+        item.rank = r * 100 / n;
+      });
+      cbs.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.community_building_score = 1 + r % 50;
+        item.rank = spread(r, n) * 100 / n;
+      });
+      txpoints.emplace(contracts::harvest, [&](auto & item) {
+        item.account = account;
+        item.points = 1 + r % 777;
+        item.rank = spread(r + 1, n) * 100 / n;
+      });
+      members.emplace(contracts::bioregion, [&](auto & item) {
+        item.account = account;
+        item.bioregion = name("bio" + std::to_string(1 + i % 5) + ".bdc");
+      });
+
+      action transfer(permission_level{ account, "active"_n }, contracts::token, "transfer"_n,
+        std::make_tuple(account, contracts::harvest, asset(10000 * (1 + r % 5000), seeds_symbol), std::string("")));
+      mock::notify(contracts::harvest, transfer);
+    }
+
+    harvest::size_tables sizes(contracts::harvest, contracts::harvest.value);
+    sizes.emplace(contracts::harvest, [&](auto & item) { item.id = "txpt.sz"_n; item.size = n; });
+
+    // planting queued every account - start from calculated scores
+    bench::push(contracts::harvest, "calccss"_n);
+    bench::run_deferred();
+  }
+
+  void harvest_calc_contribution_score(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    harvest h(contracts::harvest, contracts::harvest, datastream<const char*>(nullptr, 0));
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      name account = bench::account(spread(i++, n));
+      h.calc_contribution_score(account, "individual"_n);
+    }
+  }
+  BENCHMARK(harvest_calc_contribution_score)->range(10000, 1000000);
+
+  // the hourly pass when 1% of the users had a rank change
+  void harvest_calccss_queued(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    std::vector<name> changed;
+    for (uint64_t i = 0; i < n / 100; i++) {
+      changed.push_back(bench::account(spread(i, n)));
+    }
+    bench::push(contracts::harvest, "queuecs"_n, changed);
+
+    state.set_items_processed(changed.size());
+    for (auto _ : state) {
+      bench::push(contracts::harvest, "calccss"_n);
+      bench::run_deferred();
+    }
+  }
+  BENCHMARK(harvest_calccss_queued)->range(10000, 1000000);
+
+  // the daily pass over every user - tx points, contribution points and bioregion sums, then all ranks
+  void harvest_calcscores_full(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    state.set_items_processed(n);
+    for (auto _ : state) {
+      bench::push(contracts::harvest, "calcscores"_n);
+      bench::run_deferred();
+    }
+  }
+  BENCHMARK(harvest_calcscores_full)->range(10000, 100000);
+
+  void harvest_plant(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      name account = bench::account(spread(i++, n));
+      action transfer(permission_level{ account, "active"_n }, contracts::token, "transfer"_n,
+        std::make_tuple(account, contracts::harvest, asset(10000, seeds_symbol), std::string("")));
+      mock::notify(contracts::harvest, transfer);
+    }
+  }
+  BENCHMARK(harvest_plant)->range(10000, 1000000);
+
+}
+
+BENCHMARK_MAIN()
@@ -0,0 +1,95 @@
+#include <eosio/eosio.hpp>
+
+#define private public
+#define apply settings_apply
+#include <seeds.settings.cpp>
+#undef apply
+#include <seeds.history.cpp>
+#undef private
+
+#include "bench.hpp"
+#include <tables/rep_table.hpp>
+
+using namespace eosio;
+
+namespace {
+
+  const symbol seeds_symbol = symbol("SEEDS", 4);
+
+  // history reads the rep rank through utils::get_rep_multiplier
+  DEFINE_REP_TABLE
+  DEFINE_REP_TABLE_MULTI_INDEX
+
+  uint64_t spread(uint64_t i, uint64_t n) {
+    return (i * 7919) % n;
+  }
+
+  // n users with reputation, every tenth an organization
+  void populate_users(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::history, &apply);
+
+    history::user_tables users(contracts::accounts, contracts::accounts.value);
+    history::userstatus_tables userstatus(contracts::accounts, contracts::accounts.value);
+    rep_tables rep(contracts::accounts, contracts::accounts.value);
+
+    for (uint64_t i = 0; i < n; i++) {
+      name account = bench::account(i);
+      name type = i % 10 == 0 ? "organisation"_n : "individual"_n;
+
+      users.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.status = "citizen"_n;
+        item.type = type;
+      });
+      userstatus.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.status = "citizen"_n;
+        item.type = type;
+      });
+      rep.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.rep = 1 + spread(i, n) % 1000;
+        item.rank = spread(i, n) * 100 / n;
+      });
+    }
+  }
+
+  // a transfer between two users - the transaction row, totals, points, qev and the tx points window
+  void history_trxentry(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      name from = bench::account(spread(i, n));
+      name to = bench::account(spread(i + 1, n));
+      bench::push(contracts::history, "trxentry"_n, from, to, asset(10000 * (1 + i % 100), seeds_symbol));
+      mock::now_us() += 60 * 1000000ull;
+      i++;
+    }
+  }
+  BENCHMARK(history_trxentry)->range(10000, 1000000);
+
+  // the same pair over and over - every transfer past htry.trx.max drops the smallest one of the pair
+  void history_trxentry_same_pair(bench::state & state) {
+    uint64_t n = state.range();
+    populate_users(n);
+
+    name from = bench::account(1);
+    name to = bench::account(2);
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      bench::push(contracts::history, "trxentry"_n, from, to, asset(10000 * (1 + i % 100), seeds_symbol));
+      mock::now_us() += 60 * 1000000ull;
+      i++;
+    }
+  }
+  BENCHMARK(history_trxentry_same_pair)->arg(10000);
+
+}
+
+BENCHMARK_MAIN()
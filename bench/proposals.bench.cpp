@@ -0,0 +1,110 @@
+#include <eosio/eosio.hpp>
+
+#define private public
+#define apply settings_apply
+#include <seeds.settings.cpp>
+#undef apply
+#include <seeds.proposals.cpp>
+#undef private
+
+#include "bench.hpp"
+
+using namespace eosio;
+
+namespace {
+
+  const symbol seeds_symbol = symbol("SEEDS", 4);
+
+  const uint64_t active_proposals = 20;
+  const uint64_t staged_proposals = 10;
+
+  // n proposals of past cycles, a few active and staged ones on top, and a voter (campaign and
+  // alliance voice) for every tenth proposal
+  void populate_proposals(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::proposals, &apply);
+    bench::push(contracts::proposals, "reset"_n);
+
+    proposals::proposal_tables props(contracts::proposals, contracts::proposals.value);
+    proposals::voice_tables voice(contracts::proposals, contracts::proposals.value);
+    proposals::voice_tables voice_alliance(contracts::proposals, "alliance"_n.value);
+    proposals::active_tables actives(contracts::proposals, contracts::proposals.value);
+    proposals::size_tables sizes(contracts::proposals, contracts::proposals.value);
+
+    uint64_t done = n - active_proposals - staged_proposals;
+    std::string description(500, 'x');
+
+    for (uint64_t i = 0; i < n; i++) {
+      props.emplace(contracts::proposals, [&](auto & item) {
+        item.id = i + 1;
+        item.creator = bench::account(i % 1000);
+        item.recipient = bench::account(i % 1000);
+        item.quantity = asset(10000 * 1000, seeds_symbol);
+        item.staked = asset(i < done ? 0 : 10000 * 1000, seeds_symbol);
+        item.executed = i < done && i % 2 == 0;
+        item.total = 0;
+        item.favour = i < done ? 100 : 1000000;
+        item.against = i < done ? 10 : 0;
+        item.title = "proposal " + std::to_string(i + 1);
+        item.summary = "summary of proposal " + std::to_string(i + 1);
+        item.description = description;
+        item.image = "https://example.com/image.png";
+        item.url = "https://example.com";
+        item.fund = bankaccts::campaigns;
+        item.creation_date = 0;
+        item.pay_percentages = { 25, 25, 25, 25 };
+        item.passed_cycle = 0;
+        item.age = 0;
+        item.current_payout = asset(0, seeds_symbol);
+        if (i < done) {
+          item.status = i % 2 == 0 ? name("passed") : name("rejected");
+          item.stage = name("done");
+        } else if (i < done + active_proposals) {
+          item.status = name("open");
+          item.stage = name("active");
+        } else {
+          item.status = name("open");
+          item.stage = name("staged");
+        }
+      });
+    }
+
+    uint64_t voters = n / 10;
+    for (uint64_t i = 0; i < voters; i++) {
+      name account = bench::account(i);
+      voice.emplace(contracts::proposals, [&](auto & item) {
+        item.account = account;
+        item.balance = 100;
+      });
+      voice_alliance.emplace(contracts::proposals, [&](auto & item) {
+        item.account = account;
+        item.balance = 100;
+      });
+      actives.emplace(contracts::proposals, [&](auto & item) {
+        item.account = account;
+        item.timestamp = eosio::current_time_point().sec_since_epoch();
+      });
+    }
+
+    sizes.emplace(contracts::proposals, [&](auto & item) { item.id = "prop.act.sz"_n; item.size = active_proposals; });
+    sizes.emplace(contracts::proposals, [&](auto & item) { item.id = "user.act.sz"_n; item.size = voters; });
+    sizes.emplace(contracts::proposals, [&](auto & item) { item.id = "voice.sz"_n; item.size = voters; });
+  }
+
+  // one proposal cycle - evaluating the active proposals, activating the staged ones and updating the
+  // voices, per proposal in the table
+  void proposals_onperiod(bench::state & state) {
+    uint64_t n = state.range();
+    populate_proposals(n);
+
+    state.set_items_processed(n);
+    for (auto _ : state) {
+      bench::push(contracts::proposals, "onperiod"_n);
+      bench::run_deferred();
+    }
+  }
+  BENCHMARK(proposals_onperiod)->range(10000, 1000000);
+
+}
+
+BENCHMARK_MAIN()
@@ -0,0 +1,327 @@
+#pragma once
+
+namespace eosio {
+
+   static constexpr name same_payer{};
+
+   struct permission_level {
+      permission_level(name a, name p) : actor(a), permission(p) {}
+      permission_level() {}
+      name actor;
+      name permission;
+      friend bool operator==(const permission_level& a, const permission_level& b) {
+         return a.actor == b.actor && a.permission == b.permission;
+      }
+      EOSLIB_SERIALIZE(permission_level, (actor)(permission))
+   };
+
+   struct action {
+      eosio::name account;
+      eosio::name name;
+      std::vector<permission_level> authorization;
+      std::vector<char> data;
+
+      action() = default;
+
+      template <typename T>
+      action(const permission_level& auth, eosio::name a, eosio::name n, T&& value)
+         : account(a), name(n), authorization(1, auth), data(mock::pack(std::forward<T>(value))) {}
+
+      template <typename T>
+      action(std::vector<permission_level> auths, eosio::name a, eosio::name n, T&& value)
+         : account(a), name(n), authorization(std::move(auths)), data(mock::pack(std::forward<T>(value))) {}
+
+      template <typename T>
+      T data_as() const { return mock::unpack<T>(data); }
+
+      void send() const;
+      void send_context_free() const { send(); }
+
+      EOSLIB_SERIALIZE(action, (account)(name)(authorization)(data))
+   };
+
+   struct transaction_header {
+      time_point_sec expiration;
+      uint16_t ref_block_num = 0;
+      uint32_t ref_block_prefix = 0;
+      uint32_t max_net_usage_words = 0;
+      uint8_t max_cpu_usage_ms = 0;
+      uint32_t delay_sec = 0;
+   };
+
+   struct transaction : transaction_header {
+      transaction(time_point_sec exp = time_point_sec(current_time_point()) + 60) { expiration = exp; }
+
+      void send(const uint128_t& sender_id, name payer, bool replace_existing = false) const;
+
+      std::vector<action> context_free_actions;
+      std::vector<action> actions;
+      std::vector<std::pair<uint16_t, std::vector<char>>> transaction_extensions;
+   };
+
+   namespace mock {
+      using apply_fn = void (*)(uint64_t, uint64_t, uint64_t);
+
+      struct deferred_entry {
+         name sender;
+         uint128_t sender_id;
+         name payer;
+         int64_t ready_us;
+         uint64_t seq;
+         transaction trx;
+      };
+
+      struct chain_counters {
+         uint64_t actions_executed = 0;
+         uint64_t inline_sent = 0;
+         uint64_t deferred_sent = 0;
+         uint64_t deferred_replaced = 0;
+         uint64_t deferred_cancelled = 0;
+         uint64_t notifications = 0;
+      };
+
+      struct chain_state {
+         name receiver;
+         name code;
+         std::vector<char> action_data;
+         std::vector<permission_level> authorization;
+
+         std::deque<action> inline_queue;
+         std::vector<deferred_entry> deferred;
+         uint64_t deferred_seq = 0;
+
+         std::map<uint64_t, apply_fn> contracts;
+         std::vector<action> external_actions;
+         std::set<uint64_t> missing_accounts;
+         bool authorize_everything = true;
+         bool record_external = false;
+
+         chain_counters counters;
+      };
+
+      inline chain_state& chain() { static chain_state c; return c; }
+
+      inline void register_contract(name account, apply_fn fn) { chain().contracts[account.value] = fn; }
+
+      inline void run_one(const action& a) {
+         auto& c = chain();
+         auto it = c.contracts.find(a.account.value);
+         if (it == c.contracts.end()) {
+            if (c.record_external) c.external_actions.push_back(a);
+            return;
+         }
+         auto saved_receiver = c.receiver;
+         auto saved_code = c.code;
+         auto saved_data = std::move(c.action_data);
+         auto saved_auth = std::move(c.authorization);
+         c.receiver = a.account;
+         c.code = a.account;
+         c.action_data = a.data;
+         c.authorization = a.authorization;
+         c.counters.actions_executed++;
+         it->second(a.account.value, a.account.value, a.name.value);
+         c.receiver = saved_receiver;
+         c.code = saved_code;
+         c.action_data = std::move(saved_data);
+         c.authorization = std::move(saved_auth);
+      }
+
+      /** Delivers a notification of action a (sent to a.account) to receiver, as require_recipient would. */
+      inline void notify(name receiver, const action& a) {
+         auto& c = chain();
+         auto it = c.contracts.find(receiver.value);
+         if (it == c.contracts.end()) return;
+         auto saved_receiver = c.receiver;
+         auto saved_code = c.code;
+         auto saved_data = std::move(c.action_data);
+         auto saved_auth = std::move(c.authorization);
+         c.receiver = receiver;
+         c.code = a.account;
+         c.action_data = a.data;
+         c.authorization = a.authorization;
+         c.counters.actions_executed++;
+         it->second(receiver.value, a.account.value, a.name.value);
+         c.receiver = saved_receiver;
+         c.code = saved_code;
+         c.action_data = std::move(saved_data);
+         c.authorization = std::move(saved_auth);
+         while (!c.inline_queue.empty()) {
+            action next = std::move(c.inline_queue.front());
+            c.inline_queue.pop_front();
+            run_one(next);
+         }
+      }
+
+      /**
+       * Runs an action and every inline action it (transitively) sends.
+       * Table writes are not rolled back when an action fails.
+       */
+      inline void push_action(const action& a) {
+         auto& c = chain();
+         run_one(a);
+         while (!c.inline_queue.empty()) {
+            action next = std::move(c.inline_queue.front());
+            c.inline_queue.pop_front();
+            run_one(next);
+         }
+      }
+
+      template <typename... Args>
+      void push(name contract, name act, Args&&... args) {
+         push_action(action(permission_level{contract, name("active")}, contract, act,
+            std::make_tuple(std::forward<Args>(args)...)));
+      }
+
+      /** Executes due deferred transactions, oldest first, at most max_count of them. Returns the number run. */
+      inline uint64_t run_deferred(uint64_t max_count = std::numeric_limits<uint64_t>::max(), bool advance_clock = true) {
+         auto& c = chain();
+         uint64_t ran = 0;
+         while (ran < max_count && !c.deferred.empty()) {
+            auto best = std::min_element(c.deferred.begin(), c.deferred.end(), [](const deferred_entry& a, const deferred_entry& b) {
+               return a.ready_us != b.ready_us ? a.ready_us < b.ready_us : a.seq < b.seq;
+            });
+            if (best->ready_us > now_us()) {
+               if (!advance_clock) break;
+               now_us() = best->ready_us;
+            }
+            transaction trx = std::move(best->trx);
+            c.deferred.erase(best);
+            for (const auto& a : trx.actions) push_action(a);
+            ran++;
+         }
+         return ran;
+      }
+
+      inline bool authorized(name n) {
+         auto& c = chain();
+         if (c.authorize_everything) return true;
+         for (const auto& p : c.authorization) if (p.actor == n) return true;
+         return false;
+      }
+   }
+
+   inline void action::send() const {
+      mock::chain().counters.inline_sent++;
+      mock::chain().inline_queue.push_back(*this);
+   }
+
+   inline void transaction::send(const uint128_t& sender_id, name payer, bool replace_existing) const {
+      auto& c = mock::chain();
+      for (auto it = c.deferred.begin(); it != c.deferred.end(); ++it) {
+         if (it->sender == c.receiver && it->sender_id == sender_id) {
+            check(replace_existing, "deferred transaction with the same sender_id and payer already exists");
+            c.deferred.erase(it);
+            c.counters.deferred_replaced++;
+            break;
+         }
+      }
+      c.counters.deferred_sent++;
+      c.deferred.push_back(mock::deferred_entry{ c.receiver, sender_id, payer,
+         mock::now_us() + int64_t(delay_sec) * 1000000, c.deferred_seq++, *this });
+   }
+
+   inline int cancel_deferred(const uint128_t& sender_id) {
+      auto& c = mock::chain();
+      for (auto it = c.deferred.begin(); it != c.deferred.end(); ++it) {
+         if (it->sender == c.receiver && it->sender_id == sender_id) {
+            c.deferred.erase(it);
+            c.counters.deferred_cancelled++;
+            return 1;
+         }
+      }
+      return 0;
+   }
+
+   inline void require_auth(name n) { check(mock::authorized(n), "missing authority of " + n.to_string()); }
+   inline void require_auth(const permission_level& p) { require_auth(p.actor); }
+   inline bool has_auth(name n) { return mock::authorized(n); }
+   inline bool is_account(name n) { return mock::chain().missing_accounts.count(n.value) == 0; }
+   inline bool is_account(uint64_t n) { return is_account(name(n)); }
+   inline void require_recipient(name) { mock::chain().counters.notifications++; }
+   template <typename... Names>
+   void require_recipient(name n, Names... ns) { require_recipient(n); require_recipient(ns...); }
+   inline name current_receiver() { return mock::chain().receiver; }
+
+   class contract {
+   public:
+      contract(name self, name first_receiver, datastream<const char*> ds)
+         : _self(self), _first_receiver(first_receiver), _code(first_receiver), _ds(ds) {}
+      inline name get_self() const { return _self; }
+      inline name get_code() const { return _first_receiver; }
+      inline name get_first_receiver() const { return _first_receiver; }
+      inline datastream<const char*>& get_datastream() { return _ds; }
+      inline const datastream<const char*>& get_datastream() const { return _ds; }
+   protected:
+      name _self;
+      name _first_receiver;
+      name _code;
+      datastream<const char*> _ds;
+   };
+
+   namespace mock {
+      template <typename T> struct member_fn_traits;
+      template <typename C, typename R, typename... Args>
+      struct member_fn_traits<R (C::*)(Args...)> {
+         using class_type = C;
+         using args = std::tuple<std::decay_t<Args>...>;
+      };
+      template <typename C, typename R, typename... Args>
+      struct member_fn_traits<R (C::*)(Args...) const> {
+         using class_type = C;
+         using args = std::tuple<std::decay_t<Args>...>;
+      };
+   }
+
+   template <typename T, typename R, typename... Args>
+   bool execute_action(name self, name code, R (T::*func)(Args...)) {
+      std::tuple<std::decay_t<Args>...> args;
+      const auto& data = mock::chain().action_data;
+      mock::reader r{ data.data(), data.data() + data.size() };
+      mock::unpack(r, args);
+      T inst(self, code, datastream<const char*>(data.data(), data.size()));
+      std::apply([&](auto&... a) { (inst.*func)(a...); }, args);
+      return true;
+   }
+
+   template <name::raw Name, auto Action>
+   struct action_wrapper {
+      using args_type = typename mock::member_fn_traits<decltype(Action)>::args;
+
+      template <typename Code>
+      action_wrapper(Code&& c, std::vector<permission_level>&& perms) : code_name(std::forward<Code>(c)), permissions(std::move(perms)) {}
+      template <typename Code>
+      action_wrapper(Code&& c, const std::vector<permission_level>& perms) : code_name(std::forward<Code>(c)), permissions(perms) {}
+      template <typename Code>
+      action_wrapper(Code&& c, permission_level&& perm) : code_name(std::forward<Code>(c)), permissions({ perm }) {}
+      template <typename Code>
+      action_wrapper(Code&& c, const permission_level& perm) : code_name(std::forward<Code>(c)), permissions({ perm }) {}
+      template <typename Code>
+      action_wrapper(Code&& c) : code_name(std::forward<Code>(c)) {}
+
+      template <typename... Args>
+      action to_action(Args&&... args) const {
+         return action(permissions, code_name, name(Name), args_type(std::forward<Args>(args)...));
+      }
+      template <typename... Args>
+      void send(Args&&... args) const { to_action(std::forward<Args>(args)...).send(); }
+
+      name code_name;
+      std::vector<permission_level> permissions;
+   };
+}
+
+#define EOSIO_MOCK_CASE_A(x) case eosio::name(#x).value: eosio::execute_action(eosio::name(receiver), eosio::name(code), &_eosio_mock_type::x); break; EOSIO_MOCK_CASE_B
+#define EOSIO_MOCK_CASE_B(x) case eosio::name(#x).value: eosio::execute_action(eosio::name(receiver), eosio::name(code), &_eosio_mock_type::x); break; EOSIO_MOCK_CASE_A
+#define EOSIO_MOCK_CASE_A_END
+#define EOSIO_MOCK_CASE_B_END
+
+#define EOSIO_DISPATCH_HELPER(TYPE, MEMBERS) \
+   using _eosio_mock_type = TYPE; \
+   EOSIO_MOCK_CAT(EOSIO_MOCK_CASE_A MEMBERS, _END)
+
+#define EOSIO_DISPATCH(TYPE, MEMBERS) \
+   extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) { \
+      if (code == receiver) { \
+         switch (action) { EOSIO_DISPATCH_HELPER(TYPE, MEMBERS) } \
+      } \
+   }
@@ -0,0 +1,484 @@
+#pragma once
+
+namespace eosio {
+
+   namespace mock {
+      struct db_counters {
+         uint64_t reads = 0;          // lookups / iterator steps that landed on a row
+         uint64_t bytes_read = 0;     // serialized size of those rows
+         uint64_t writes = 0;         // emplace + modify + erase
+         uint64_t bytes_written = 0;  // serialized size of written rows (erase counts the removed row)
+         uint64_t emplaced = 0;
+         uint64_t modified = 0;
+         uint64_t erased = 0;
+
+         db_counters operator-(const db_counters& o) const {
+            db_counters r;
+            r.reads = reads - o.reads;
+            r.bytes_read = bytes_read - o.bytes_read;
+            r.writes = writes - o.writes;
+            r.bytes_written = bytes_written - o.bytes_written;
+            r.emplaced = emplaced - o.emplaced;
+            r.modified = modified - o.modified;
+            r.erased = erased - o.erased;
+            return r;
+         }
+      };
+      inline db_counters& db() { static db_counters c; return c; }
+
+      struct row_data {
+         std::vector<char> bytes;
+         uint64_t version = 0;
+      };
+
+      struct index_entry {
+         uint64_t index_name;
+         std::type_index key_type;
+         std::shared_ptr<void> set;
+         std::function<void(uint64_t pk, const std::vector<char>* old_bytes, const std::vector<char>* new_bytes)> update;
+      };
+
+      /** Rows of one code / table / scope, shared by every multi_index definition of that table. */
+      struct table_store {
+         std::map<uint64_t, row_data> rows;
+         std::vector<index_entry> indices;
+         uint64_t versions = 0;
+         uint64_t bytes = 0;
+
+         void write(uint64_t pk, std::vector<char>* new_bytes) {
+            auto it = rows.find(pk);
+            const std::vector<char>* old_bytes = it == rows.end() ? nullptr : &it->second.bytes;
+            for (auto& idx : indices) idx.update(pk, old_bytes, new_bytes);
+            if (old_bytes) bytes -= old_bytes->size();
+            if (new_bytes) {
+               bytes += new_bytes->size();
+               auto& row = rows[pk];
+               row.bytes = std::move(*new_bytes);
+               row.version = ++versions;
+            } else if (it != rows.end()) {
+               rows.erase(it);
+            }
+         }
+      };
+
+      struct store_key {
+         uint64_t code;
+         uint64_t table;
+         uint64_t scope;
+         bool operator<(const store_key& o) const {
+            return std::tie(code, table, scope) < std::tie(o.code, o.table, o.scope);
+         }
+      };
+
+      inline std::map<store_key, std::shared_ptr<table_store>>& stores() {
+         static std::map<store_key, std::shared_ptr<table_store>> s;
+         return s;
+      }
+
+      /** Serialized bytes held by a table over all scopes (no per-row chain overhead included). */
+      inline uint64_t table_bytes(name code, name table) {
+         uint64_t total = 0;
+         for (const auto& kv : stores())
+            if (kv.first.code == code.value && kv.first.table == table.value) total += kv.second->bytes;
+         return total;
+      }
+
+      inline uint64_t table_rows(name code, name table) {
+         uint64_t total = 0;
+         for (const auto& kv : stores())
+            if (kv.first.code == code.value && kv.first.table == table.value) total += kv.second->rows.size();
+         return total;
+      }
+
+      /** Forgets every table row, pending action and counter. */
+      inline void reset_all() {
+         stores().clear();
+         db() = db_counters{};
+         chain().inline_queue.clear();
+         chain().deferred.clear();
+         chain().external_actions.clear();
+         chain().counters = chain_counters{};
+      }
+
+      inline void count_read(const row_data& row) {
+         db().reads++;
+         db().bytes_read += row.bytes.size();
+      }
+   }
+
+   template <typename Class, typename Type, Type (Class::*PtrToMemberFunction)() const>
+   struct const_mem_fun {
+      typedef std::remove_cv_t<std::remove_reference_t<Type>> result_type;
+      result_type operator()(const Class& x) const { return (x.*PtrToMemberFunction)(); }
+   };
+
+   template <name::raw IndexName, typename Extractor>
+   struct indexed_by {
+      static constexpr name::raw index_name = IndexName;
+      typedef Extractor secondary_extractor_type;
+   };
+
+   template <name::raw TableName, typename T, typename... Indices>
+   class multi_index {
+      struct cached {
+         uint64_t version;
+         std::unique_ptr<T> obj;
+      };
+
+      /** Deserialized copies of rows, like the object cache of the real multi_index. */
+      struct view {
+         std::shared_ptr<mock::table_store> store;
+         std::map<uint64_t, cached> cache;
+
+         const T& load(uint64_t pk) {
+            auto rit = store->rows.find(pk);
+            check(rit != store->rows.end(), "dereference of erased row");
+            auto& c = cache[pk];
+            if (!c.obj) {
+               c.obj = std::make_unique<T>(mock::unpack<T>(rit->second.bytes));
+               c.version = rit->second.version;
+            } else if (c.version != rit->second.version) {
+               *c.obj = mock::unpack<T>(rit->second.bytes);
+               c.version = rit->second.version;
+            }
+            return *c.obj;
+         }
+      };
+
+      template <size_t I>
+      using index_t = std::tuple_element_t<I, std::tuple<Indices...>>;
+      template <size_t I>
+      using key_t = typename index_t<I>::secondary_extractor_type::result_type;
+      template <size_t I>
+      using set_t = std::set<std::pair<key_t<I>, uint64_t>>;
+
+      name _code;
+      uint64_t _scope;
+      std::shared_ptr<view> _view;
+      std::array<std::shared_ptr<void>, sizeof...(Indices) + 1> _sets;
+
+      template <size_t I>
+      void attach_index() {
+         auto& store = *_view->store;
+         uint64_t n = uint64_t(index_t<I>::index_name);
+         for (auto& e : store.indices) {
+            if (e.index_name == n) {
+               check(e.key_type == std::type_index(typeid(key_t<I>)), "mock: index key type differs between table definitions");
+               _sets[I] = e.set;
+               return;
+            }
+         }
+         auto set = std::make_shared<set_t<I>>();
+         for (const auto& kv : store.rows) {
+            typename index_t<I>::secondary_extractor_type ex;
+            set->emplace(ex(mock::unpack<T>(kv.second.bytes)), kv.first);
+         }
+         std::weak_ptr<set_t<I>> weak = set;
+         store.indices.push_back(mock::index_entry{ n, std::type_index(typeid(key_t<I>)), set,
+            [weak](uint64_t pk, const std::vector<char>* old_bytes, const std::vector<char>* new_bytes) {
+               auto s = weak.lock();
+               if (!s) return;
+               typename index_t<I>::secondary_extractor_type ex;
+               if (old_bytes) s->erase(std::make_pair(ex(mock::unpack<T>(*old_bytes)), pk));
+               if (new_bytes) s->emplace(ex(mock::unpack<T>(*new_bytes)), pk);
+            } });
+         _sets[I] = set;
+      }
+
+      template <size_t... I>
+      void attach_indices(std::index_sequence<I...>) { (attach_index<I>(), ...); }
+
+      template <name::raw N, size_t I = 0>
+      static constexpr size_t index_position() {
+         static_assert(I < sizeof...(Indices), "name not found in indices");
+         if constexpr (index_t<I>::index_name == N) {
+            return I;
+         } else {
+            return index_position<N, I + 1>();
+         }
+      }
+
+      void write(uint64_t pk, const T* obj) {
+         auto& store = *_view->store;
+         mock::db().writes++;
+         if (obj) {
+            auto bytes = mock::pack(*obj);
+            mock::db().bytes_written += bytes.size();
+            store.write(pk, &bytes);
+         } else {
+            auto it = store.rows.find(pk);
+            if (it != store.rows.end()) mock::db().bytes_written += it->second.bytes.size();
+            store.write(pk, nullptr);
+            _view->cache.erase(pk);
+         }
+      }
+
+   public:
+      multi_index(name code, uint64_t scope) : _code(code), _scope(scope) {
+         auto& slot = mock::stores()[mock::store_key{ code.value, uint64_t(TableName), scope }];
+         if (!slot) slot = std::make_shared<mock::table_store>();
+         _view = std::make_shared<view>();
+         _view->store = slot;
+         attach_indices(std::index_sequence_for<Indices...>{});
+      }
+
+      name get_code() const { return _code; }
+      uint64_t get_scope() const { return _scope; }
+
+      class const_iterator {
+      public:
+         using iterator_category = std::bidirectional_iterator_tag;
+         using value_type = const T;
+         using difference_type = std::ptrdiff_t;
+         using pointer = const T*;
+         using reference = const T&;
+
+         const_iterator() {}
+         const_iterator(view* v, std::optional<uint64_t> pk) : _v(v), _pk(pk) {}
+
+         const T& operator*() const {
+            check(_pk.has_value(), "cannot dereference end iterator");
+            return _v->load(*_pk);
+         }
+         const T* operator->() const { return &**this; }
+
+         const_iterator& operator++() {
+            check(_pk.has_value(), "cannot increment end iterator");
+            auto& rows = _v->store->rows;
+            auto it = rows.upper_bound(*_pk);
+            if (it == rows.end()) {
+               _pk.reset();
+            } else {
+               _pk = it->first;
+               mock::count_read(it->second);
+            }
+            return *this;
+         }
+         const_iterator operator++(int) { auto r = *this; ++*this; return r; }
+         const_iterator& operator--() {
+            auto& rows = _v->store->rows;
+            auto it = _pk ? rows.lower_bound(*_pk) : rows.end();
+            check(it != rows.begin(), "cannot decrement iterator at beginning of table");
+            --it;
+            _pk = it->first;
+            mock::count_read(it->second);
+            return *this;
+         }
+         const_iterator operator--(int) { auto r = *this; --*this; return r; }
+
+         friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._v == b._v && a._pk == b._pk; }
+         friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+
+      private:
+         view* _v = nullptr;
+         std::optional<uint64_t> _pk;
+      };
+      using iterator = const_iterator;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+   private:
+      const_iterator make_iterator(std::map<uint64_t, mock::row_data>::iterator it) const {
+         if (it == _view->store->rows.end()) return end();
+         mock::count_read(it->second);
+         return const_iterator(_view.get(), it->first);
+      }
+
+   public:
+      const_iterator begin() const { return make_iterator(_view->store->rows.begin()); }
+      const_iterator cbegin() const { return begin(); }
+      const_iterator end() const { return const_iterator(_view.get(), std::nullopt); }
+      const_iterator cend() const { return end(); }
+      const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+      const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+      const_iterator find(uint64_t pk) const { return make_iterator(_view->store->rows.find(pk)); }
+      const_iterator require_find(uint64_t pk, const char* msg = "unable to find key") const {
+         auto it = find(pk);
+         check(it != end(), msg);
+         return it;
+      }
+      const T& get(uint64_t pk, const char* msg = "unable to find key") const { return *require_find(pk, msg); }
+      const_iterator lower_bound(uint64_t pk) const { return make_iterator(_view->store->rows.lower_bound(pk)); }
+      const_iterator upper_bound(uint64_t pk) const { return make_iterator(_view->store->rows.upper_bound(pk)); }
+
+      const_iterator iterator_to(const T& obj) const { return const_iterator(_view.get(), obj.primary_key()); }
+
+      uint64_t available_primary_key() const {
+         auto& rows = _view->store->rows;
+         if (rows.empty()) return 0;
+         return rows.rbegin()->first + 1;
+      }
+
+      template <typename Lambda>
+      const_iterator emplace(name payer, Lambda&& constructor) {
+         T obj{};
+         constructor(obj);
+         auto pk = obj.primary_key();
+         check(_view->store->rows.find(pk) == _view->store->rows.end(),
+            "could not insert object, most likely a uniqueness constraint was violated");
+         mock::db().emplaced++;
+         write(pk, &obj);
+         return const_iterator(_view.get(), pk);
+      }
+
+      template <typename Lambda>
+      void modify(const_iterator itr, name payer, Lambda&& updater) {
+         check(itr != end(), "cannot pass end iterator to modify");
+         modify(*itr, payer, std::forward<Lambda>(updater));
+      }
+
+      template <typename Lambda>
+      void modify(const T& obj, name payer, Lambda&& updater) {
+         auto pk = obj.primary_key();
+         check(_view->store->rows.count(pk) == 1, "object passed to modify is not in multi_index");
+         T& mutable_obj = const_cast<T&>(_view->load(pk));
+         updater(mutable_obj);
+         check(pk == mutable_obj.primary_key(), "updater cannot change primary key when modifying an object");
+         mock::db().modified++;
+         write(pk, &mutable_obj);
+         _view->cache[pk].version = _view->store->rows[pk].version;
+      }
+
+      const_iterator erase(const_iterator itr) {
+         check(itr != end(), "cannot pass end iterator to erase");
+         auto next = itr;
+         ++next;
+         erase(*itr);
+         return next;
+      }
+
+      void erase(const T& obj) {
+         auto pk = obj.primary_key();
+         check(_view->store->rows.count(pk) == 1, "object passed to erase is not in multi_index");
+         mock::db().erased++;
+         write(pk, nullptr);
+      }
+
+      template <size_t I>
+      class index {
+      public:
+         using key_type = key_t<I>;
+         using set_type = set_t<I>;
+
+         class const_iterator {
+         public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = const T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator() {}
+            const_iterator(view* v, set_type* s, std::optional<std::pair<key_type, uint64_t>> pos) : _v(v), _s(s), _pos(pos) {}
+
+            const T& operator*() const {
+               check(_pos.has_value(), "cannot dereference end iterator");
+               return _v->load(_pos->second);
+            }
+            const T* operator->() const { return &**this; }
+
+            const_iterator& operator++() {
+               check(_pos.has_value(), "cannot increment end iterator");
+               auto it = _s->upper_bound(*_pos);
+               if (it == _s->end()) {
+                  _pos.reset();
+               } else {
+                  _pos = *it;
+                  mock::count_read(_v->store->rows.find(it->second)->second);
+               }
+               return *this;
+            }
+            const_iterator operator++(int) { auto r = *this; ++*this; return r; }
+            const_iterator& operator--() {
+               auto it = _pos ? _s->lower_bound(*_pos) : _s->end();
+               check(it != _s->begin(), "cannot decrement iterator at beginning of index");
+               --it;
+               _pos = *it;
+               mock::count_read(_v->store->rows.find(it->second)->second);
+               return *this;
+            }
+            const_iterator operator--(int) { auto r = *this; --*this; return r; }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._s == b._s && a._pos == b._pos; }
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+
+         private:
+            view* _v = nullptr;
+            set_type* _s = nullptr;
+            std::optional<std::pair<key_type, uint64_t>> _pos;
+         };
+         using iterator = const_iterator;
+         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+         index(multi_index* mi) : _mi(mi), _set(static_cast<set_type*>(mi->_sets[I].get())) {}
+
+      private:
+         const_iterator make(typename set_type::iterator it) const {
+            if (it == _set->end()) return end();
+            mock::count_read(_mi->_view->store->rows.find(it->second)->second);
+            return const_iterator(_mi->_view.get(), _set, *it);
+         }
+
+      public:
+         const_iterator begin() const { return make(_set->begin()); }
+         const_iterator cbegin() const { return begin(); }
+         const_iterator end() const { return const_iterator(_mi->_view.get(), _set, std::nullopt); }
+         const_iterator cend() const { return end(); }
+         const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+         const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+         const_iterator lower_bound(const key_type& k) const {
+            return make(_set->lower_bound(std::make_pair(k, uint64_t(0))));
+         }
+         const_iterator upper_bound(const key_type& k) const {
+            return make(_set->upper_bound(std::make_pair(k, std::numeric_limits<uint64_t>::max())));
+         }
+         const_iterator find(const key_type& k) const {
+            auto it = _set->lower_bound(std::make_pair(k, uint64_t(0)));
+            if (it == _set->end() || !(it->first == k)) return end();
+            return make(it);
+         }
+         const_iterator require_find(const key_type& k, const char* msg = "unable to find secondary key") const {
+            auto it = find(k);
+            check(it != end(), msg);
+            return it;
+         }
+         const T& get(const key_type& k, const char* msg = "unable to find secondary key") const { return *require_find(k, msg); }
+
+         const_iterator iterator_to(const T& obj) const {
+            typename index_t<I>::secondary_extractor_type ex;
+            return const_iterator(_mi->_view.get(), _set, std::make_pair(ex(obj), obj.primary_key()));
+         }
+
+         template <typename Lambda>
+         void modify(const_iterator itr, name payer, Lambda&& updater) {
+            check(itr != end(), "cannot pass end iterator to modify");
+            _mi->modify(*itr, payer, std::forward<Lambda>(updater));
+         }
+
+         const_iterator erase(const_iterator itr) {
+            check(itr != end(), "cannot pass end iterator to erase");
+            auto next = itr;
+            ++next;
+            _mi->erase(*itr);
+            return next;
+         }
+
+         name get_code() const { return _mi->get_code(); }
+         uint64_t get_scope() const { return _mi->get_scope(); }
+
+      private:
+         multi_index* _mi;
+         set_type* _set;
+      };
+
+      template <name::raw IndexName>
+      auto get_index() {
+         return index<index_position<IndexName>()>(this);
+      }
+      template <name::raw IndexName>
+      auto get_index() const {
+         return index<index_position<IndexName>()>(const_cast<multi_index*>(this));
+      }
+   };
+}
@@ -0,0 +1,53 @@
+// generated: structured-binding field visitor for aggregates (up to 48 fields)
+#pragma once
+namespace eosio { namespace mock { namespace refl {
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 0>) {}
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 1>) { auto& [a0] = t; f(a0); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 2>) { auto& [a0,a1] = t; f(a0);f(a1); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 3>) { auto& [a0,a1,a2] = t; f(a0);f(a1);f(a2); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 4>) { auto& [a0,a1,a2,a3] = t; f(a0);f(a1);f(a2);f(a3); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 5>) { auto& [a0,a1,a2,a3,a4] = t; f(a0);f(a1);f(a2);f(a3);f(a4); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 6>) { auto& [a0,a1,a2,a3,a4,a5] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 7>) { auto& [a0,a1,a2,a3,a4,a5,a6] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 8>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 9>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 10>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 11>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 12>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 13>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 14>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 15>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 16>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 17>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 18>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 19>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 20>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 21>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 22>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 23>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 24>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 25>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 26>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 27>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 28>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 29>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 30>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 31>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 32>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 33>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 34>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 35>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 36>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 37>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 38>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 39>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 40>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 41>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 42>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 43>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 44>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42,a43] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42);f(a43); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 45>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42,a43,a44] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42);f(a43);f(a44); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 46>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42,a43,a44,a45] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42);f(a43);f(a44);f(a45); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 47>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42,a43,a44,a45,a46] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42);f(a43);f(a44);f(a45);f(a46); }
+template <typename T, typename F> void visit_n(T& t, F&& f, std::integral_constant<std::size_t, 48>) { auto& [a0,a1,a2,a3,a4,a5,a6,a7,a8,a9,a10,a11,a12,a13,a14,a15,a16,a17,a18,a19,a20,a21,a22,a23,a24,a25,a26,a27,a28,a29,a30,a31,a32,a33,a34,a35,a36,a37,a38,a39,a40,a41,a42,a43,a44,a45,a46,a47] = t; f(a0);f(a1);f(a2);f(a3);f(a4);f(a5);f(a6);f(a7);f(a8);f(a9);f(a10);f(a11);f(a12);f(a13);f(a14);f(a15);f(a16);f(a17);f(a18);f(a19);f(a20);f(a21);f(a22);f(a23);f(a24);f(a25);f(a26);f(a27);f(a28);f(a29);f(a30);f(a31);f(a32);f(a33);f(a34);f(a35);f(a36);f(a37);f(a38);f(a39);f(a40);f(a41);f(a42);f(a43);f(a44);f(a45);f(a46);f(a47); }
+}}}
@@ -0,0 +1,737 @@
+/**
+ * Host-side stand-in for the subset of the eosio.cdt API used by the seeds contracts.
+ *
+ * Tables are kept in memory (one store per code/table/scope), rows are serialized only to
+ * account for the bytes that would be read from / written to chain RAM. Inline actions and
+ * deferred transactions are queued and can be executed by the harness.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+typedef unsigned __int128 uint128_t;
+typedef __int128 int128_t;
+
+#define CONTRACT class [[eosio::contract]]
+#define ACTION [[eosio::action]] void
+#define TABLE struct [[eosio::table]]
+
+namespace eosio {
+
+   // ------------------------------------------------------------------ check / print
+
+   struct eosio_assert_exception : std::runtime_error {
+      using std::runtime_error::runtime_error;
+   };
+
+   inline void check(bool pred, const char* msg) {
+      if (!pred) throw eosio_assert_exception(msg);
+   }
+   inline void check(bool pred, const std::string& msg) {
+      if (!pred) throw eosio_assert_exception(msg);
+   }
+   inline void check(bool pred, std::string_view msg) {
+      if (!pred) throw eosio_assert_exception(std::string(msg));
+   }
+   inline void check(bool pred, uint64_t code) {
+      if (!pred) throw eosio_assert_exception("assertion failure with code " + std::to_string(code));
+   }
+
+   namespace mock {
+      inline bool& print_enabled() { static bool enabled = false; return enabled; }
+      inline std::ostream& out() { return std::cout; }
+   }
+
+   // ------------------------------------------------------------------ name
+
+   struct name {
+      enum class raw : uint64_t {};
+
+      constexpr name() : value(0) {}
+      constexpr explicit name(uint64_t v) : value(v) {}
+      constexpr explicit name(raw r) : value(static_cast<uint64_t>(r)) {}
+      constexpr explicit name(std::string_view str) : value(0) {
+         if (str.size() > 13) {
+            throw eosio_assert_exception("string is too long to be a valid name");
+         }
+         if (str.empty()) {
+            return;
+         }
+         auto n = std::min((uint32_t)str.size(), (uint32_t)12u);
+         for (decltype(n) i = 0; i < n; ++i) {
+            value <<= 5;
+            value |= char_to_value(str[i]);
+         }
+         value <<= (4 + 5 * (12 - n));
+         if (str.size() == 13) {
+            uint64_t v = char_to_value(str[12]);
+            if (v > 0x0Full) {
+               throw eosio_assert_exception("thirteenth character in name cannot be a letter that comes after j");
+            }
+            value |= v;
+         }
+      }
+
+      static constexpr uint8_t char_to_value(char c) {
+         if (c == '.')
+            return 0;
+         else if (c >= '1' && c <= '5')
+            return (c - '1') + 1;
+         else if (c >= 'a' && c <= 'z')
+            return (c - 'a') + 6;
+         else
+            throw eosio_assert_exception("character is not in allowed character set for names");
+         return 0;
+      }
+
+      constexpr uint8_t length() const {
+         constexpr uint64_t mask = 0xF800000000000000ull;
+         if (value == 0) return 0;
+         uint8_t l = 0;
+         uint8_t i = 0;
+         for (auto v = value; i < 13; ++i, v <<= 5) {
+            if ((v & mask) > 0) l = i;
+         }
+         return l + 1;
+      }
+
+      constexpr name suffix() const {
+         uint32_t remaining_bits_after_last_actual_dot = 0;
+         uint32_t tmp = 0;
+         for (int32_t remaining_bits = 59; remaining_bits >= 4; remaining_bits -= 5) {
+            auto c = (value >> remaining_bits) & 0x1Full;
+            if (!c) {
+               tmp = static_cast<uint32_t>(remaining_bits);
+            } else {
+               remaining_bits_after_last_actual_dot = tmp;
+            }
+         }
+         uint64_t thirteenth_character = value & 0x0Full;
+         if (thirteenth_character) {
+            remaining_bits_after_last_actual_dot = tmp;
+         }
+         if (remaining_bits_after_last_actual_dot == 0) return name{value};
+         uint64_t mask = (1ull << remaining_bits_after_last_actual_dot) - 16;
+         uint32_t shift = 64 - remaining_bits_after_last_actual_dot;
+         return name{((value & mask) << shift) + (thirteenth_character << (shift - 1))};
+      }
+
+      constexpr operator raw() const { return raw(value); }
+      constexpr explicit operator bool() const { return value != 0; }
+
+      std::string to_string() const {
+         static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+         std::string str(13, '.');
+         uint64_t tmp = value;
+         for (uint32_t i = 0; i <= 12; ++i) {
+            char c = charmap[tmp & (i == 0 ? 0x0f : 0x1f)];
+            str[12 - i] = c;
+            tmp >>= (i == 0 ? 4 : 5);
+         }
+         while (!str.empty() && str.back() == '.') str.pop_back();
+         return str;
+      }
+
+      void print() const { mock::out() << to_string(); }
+
+      friend constexpr bool operator==(const name& a, const name& b) { return a.value == b.value; }
+      friend constexpr bool operator!=(const name& a, const name& b) { return a.value != b.value; }
+      friend constexpr bool operator<(const name& a, const name& b) { return a.value < b.value; }
+      friend constexpr bool operator>(const name& a, const name& b) { return a.value > b.value; }
+      friend constexpr bool operator<=(const name& a, const name& b) { return a.value <= b.value; }
+      friend constexpr bool operator>=(const name& a, const name& b) { return a.value >= b.value; }
+
+      uint64_t value = 0;
+   };
+
+   // ------------------------------------------------------------------ symbol / asset
+
+   class symbol_code {
+   public:
+      constexpr symbol_code() : value(0) {}
+      constexpr explicit symbol_code(uint64_t raw) : value(raw) {}
+      constexpr explicit symbol_code(std::string_view str) : value(0) {
+         if (str.size() > 7) throw eosio_assert_exception("string is too long to be a valid symbol_code");
+         for (auto itr = str.rbegin(); itr != str.rend(); ++itr) {
+            if (*itr < 'A' || *itr > 'Z') throw eosio_assert_exception("only uppercase letters allowed in symbol_code string");
+            value <<= 8;
+            value |= *itr;
+         }
+      }
+      constexpr bool is_valid() const {
+         auto sym = value;
+         for (int i = 0; i < 7; i++) {
+            char c = (char)(sym & 0xFF);
+            if (!('A' <= c && c <= 'Z')) return false;
+            sym >>= 8;
+            if (!(sym & 0xFF)) {
+               do {
+                  sym >>= 8;
+                  if ((sym & 0xFF)) return false;
+                  i++;
+               } while (i < 7);
+            }
+         }
+         return true;
+      }
+      constexpr uint64_t raw() const { return value; }
+      constexpr explicit operator bool() const { return value != 0; }
+      std::string to_string() const {
+         std::string s;
+         auto v = value;
+         while (v & 0xFF) { s += char(v & 0xFF); v >>= 8; }
+         return s;
+      }
+      void print() const { mock::out() << to_string(); }
+      friend constexpr bool operator==(const symbol_code& a, const symbol_code& b) { return a.value == b.value; }
+      friend constexpr bool operator!=(const symbol_code& a, const symbol_code& b) { return a.value != b.value; }
+      friend constexpr bool operator<(const symbol_code& a, const symbol_code& b) { return a.value < b.value; }
+   private:
+      uint64_t value = 0;
+   };
+
+   class symbol {
+   public:
+      constexpr symbol() : value(0) {}
+      constexpr explicit symbol(uint64_t s) : value(s) {}
+      constexpr symbol(symbol_code sc, uint8_t precision) : value((sc.raw() << 8) | (uint64_t)precision) {}
+      constexpr symbol(std::string_view ss, uint8_t precision) : value((symbol_code(ss).raw() << 8) | (uint64_t)precision) {}
+      constexpr bool is_valid() const { return code().is_valid(); }
+      constexpr uint8_t precision() const { return value & 0xFFull; }
+      constexpr symbol_code code() const { return symbol_code{value >> 8}; }
+      constexpr uint64_t raw() const { return value; }
+      constexpr explicit operator bool() const { return value != 0; }
+      void print(bool show_precision = true) const {
+         if (show_precision) mock::out() << (int)precision() << ",";
+         mock::out() << code().to_string();
+      }
+      friend constexpr bool operator==(const symbol& a, const symbol& b) { return a.value == b.value; }
+      friend constexpr bool operator!=(const symbol& a, const symbol& b) { return a.value != b.value; }
+      friend constexpr bool operator<(const symbol& a, const symbol& b) { return a.value < b.value; }
+   private:
+      uint64_t value = 0;
+   };
+
+   struct asset {
+      int64_t amount = 0;
+      eosio::symbol symbol;
+
+      static constexpr int64_t max_amount = (1LL << 62) - 1;
+
+      asset() {}
+      asset(int64_t a, class symbol s) : amount(a), symbol{s} {
+         eosio::check(is_amount_within_range(), "magnitude of asset amount must be less than 2^62");
+         eosio::check(symbol.is_valid(), "invalid symbol name");
+      }
+      bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+      bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+      void set_amount(int64_t a) { amount = a; }
+
+      asset operator-() const { asset r = *this; r.amount = -r.amount; return r; }
+      asset& operator-=(const asset& a) {
+         eosio::check(a.symbol == symbol, "attempt to subtract asset with different symbol");
+         amount -= a.amount;
+         eosio::check(-max_amount <= amount, "subtraction underflow");
+         eosio::check(amount <= max_amount, "subtraction overflow");
+         return *this;
+      }
+      asset& operator+=(const asset& a) {
+         eosio::check(a.symbol == symbol, "attempt to add asset with different symbol");
+         amount += a.amount;
+         eosio::check(-max_amount <= amount, "addition underflow");
+         eosio::check(amount <= max_amount, "addition overflow");
+         return *this;
+      }
+      friend asset operator+(const asset& a, const asset& b) { asset r = a; r += b; return r; }
+      friend asset operator-(const asset& a, const asset& b) { asset r = a; r -= b; return r; }
+      asset& operator*=(int64_t a) {
+         int128_t tmp = (int128_t)amount * (int128_t)a;
+         eosio::check(tmp <= max_amount, "multiplication overflow");
+         eosio::check(tmp >= -max_amount, "multiplication underflow");
+         amount = (int64_t)tmp;
+         return *this;
+      }
+      friend asset operator*(const asset& a, int64_t b) { asset r = a; r *= b; return r; }
+      friend asset operator*(int64_t b, const asset& a) { asset r = a; r *= b; return r; }
+      asset& operator/=(int64_t a) {
+         eosio::check(a != 0, "divide by zero");
+         eosio::check(!(amount == std::numeric_limits<int64_t>::min() && a == -1), "signed division overflow");
+         amount /= a;
+         return *this;
+      }
+      friend asset operator/(const asset& a, int64_t b) { asset r = a; r /= b; return r; }
+      friend int64_t operator/(const asset& a, const asset& b) {
+         eosio::check(b.amount != 0, "divide by zero");
+         eosio::check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount / b.amount;
+      }
+      friend bool operator==(const asset& a, const asset& b) {
+         eosio::check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount == b.amount;
+      }
+      friend bool operator!=(const asset& a, const asset& b) { return !(a == b); }
+      friend bool operator<(const asset& a, const asset& b) {
+         eosio::check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+         return a.amount < b.amount;
+      }
+      friend bool operator<=(const asset& a, const asset& b) { return a < b || a == b; }
+      friend bool operator>(const asset& a, const asset& b) { return b < a; }
+      friend bool operator>=(const asset& a, const asset& b) { return b <= a; }
+
+      std::string to_string() const {
+         int64_t p = symbol.precision();
+         int64_t scale = 1;
+         for (int64_t i = 0; i < p; ++i) scale *= 10;
+         bool negative = amount < 0;
+         uint64_t abs = negative ? -amount : amount;
+         std::string s = std::to_string(abs / scale);
+         if (p > 0) {
+            std::string frac = std::to_string(abs % scale);
+            s += "." + std::string(p - frac.size(), '0') + frac;
+         }
+         return (negative ? "-" : "") + s + " " + symbol.code().to_string();
+      }
+      void print() const { mock::out() << to_string(); }
+   };
+
+   struct extended_asset {
+      asset quantity;
+      name contract;
+   };
+
+   // ------------------------------------------------------------------ time
+
+   class microseconds {
+   public:
+      explicit constexpr microseconds(int64_t c = 0) : _count(c) {}
+      constexpr int64_t count() const { return _count; }
+      constexpr int64_t to_seconds() const { return _count / 1000000; }
+      friend constexpr microseconds operator+(const microseconds& l, const microseconds& r) { return microseconds(l._count + r._count); }
+      friend constexpr microseconds operator-(const microseconds& l, const microseconds& r) { return microseconds(l._count - r._count); }
+      friend constexpr bool operator==(const microseconds& a, const microseconds& b) { return a._count == b._count; }
+      friend constexpr bool operator<(const microseconds& a, const microseconds& b) { return a._count < b._count; }
+      friend constexpr bool operator>(const microseconds& a, const microseconds& b) { return a._count > b._count; }
+      int64_t _count;
+   };
+   inline constexpr microseconds seconds(int64_t s) { return microseconds(s * 1000000); }
+   inline constexpr microseconds milliseconds(int64_t s) { return microseconds(s * 1000); }
+   inline constexpr microseconds minutes(int64_t m) { return seconds(60 * m); }
+   inline constexpr microseconds hours(int64_t h) { return minutes(60 * h); }
+   inline constexpr microseconds days(int64_t d) { return hours(24 * d); }
+
+   class time_point {
+   public:
+      explicit constexpr time_point(microseconds e = microseconds()) : elapsed(e) {}
+      constexpr const microseconds& time_since_epoch() const { return elapsed; }
+      constexpr uint32_t sec_since_epoch() const { return uint32_t(elapsed.count() / 1000000); }
+      friend constexpr bool operator>(const time_point& a, const time_point& b) { return a.elapsed._count > b.elapsed._count; }
+      friend constexpr bool operator>=(const time_point& a, const time_point& b) { return a.elapsed._count >= b.elapsed._count; }
+      friend constexpr bool operator<(const time_point& a, const time_point& b) { return a.elapsed._count < b.elapsed._count; }
+      friend constexpr bool operator<=(const time_point& a, const time_point& b) { return a.elapsed._count <= b.elapsed._count; }
+      friend constexpr bool operator==(const time_point& a, const time_point& b) { return a.elapsed._count == b.elapsed._count; }
+      friend constexpr bool operator!=(const time_point& a, const time_point& b) { return a.elapsed._count != b.elapsed._count; }
+      time_point& operator+=(const microseconds& m) { elapsed = elapsed + m; return *this; }
+      time_point& operator-=(const microseconds& m) { elapsed = elapsed - m; return *this; }
+      friend constexpr time_point operator+(const time_point& t, const microseconds& m) { return time_point(t.elapsed + m); }
+      friend constexpr time_point operator-(const time_point& t, const microseconds& m) { return time_point(t.elapsed - m); }
+      friend constexpr microseconds operator-(const time_point& a, const time_point& b) { return a.elapsed - b.elapsed; }
+      microseconds elapsed;
+   };
+
+   class time_point_sec {
+   public:
+      constexpr time_point_sec() : utc_seconds(0) {}
+      constexpr explicit time_point_sec(uint32_t seconds) : utc_seconds(seconds) {}
+      constexpr time_point_sec(const time_point& t) : utc_seconds(uint32_t(t.time_since_epoch().count() / 1000000ll)) {}
+      constexpr uint32_t sec_since_epoch() const { return utc_seconds; }
+      constexpr operator time_point() const { return time_point(eosio::seconds(utc_seconds)); }
+      friend constexpr time_point_sec operator+(const time_point_sec& t, uint32_t offset) { return time_point_sec(t.utc_seconds + offset); }
+      friend constexpr time_point_sec operator-(const time_point_sec& t, uint32_t offset) { return time_point_sec(t.utc_seconds - offset); }
+      friend constexpr bool operator<(const time_point_sec& a, const time_point_sec& b) { return a.utc_seconds < b.utc_seconds; }
+      friend constexpr bool operator>(const time_point_sec& a, const time_point_sec& b) { return a.utc_seconds > b.utc_seconds; }
+      friend constexpr bool operator==(const time_point_sec& a, const time_point_sec& b) { return a.utc_seconds == b.utc_seconds; }
+      uint32_t utc_seconds;
+   };
+
+   class block_timestamp {
+   public:
+      explicit block_timestamp(uint32_t s = 0) : slot(s) {}
+      block_timestamp(const time_point& t) { slot = uint32_t((t.time_since_epoch().count() / 1000 - 946684800000ll) / 500); }
+      time_point to_time_point() const { return time_point(milliseconds(int64_t(slot) * 500 + 946684800000ll)); }
+      operator time_point() const { return to_time_point(); }
+      uint32_t slot;
+   };
+
+   namespace mock {
+      // the clock only moves when the harness moves it
+      inline int64_t& now_us() { static int64_t t = 1600000000ll * 1000000ll; return t; }
+   }
+
+   inline time_point current_time_point() { return time_point(microseconds(mock::now_us())); }
+   inline block_timestamp current_block_time() { return block_timestamp(current_time_point()); }
+
+   // ------------------------------------------------------------------ fixed bytes / crypto
+
+   template <size_t Size>
+   class fixed_bytes {
+   public:
+      fixed_bytes() { _data.fill(0); }
+      const uint8_t* data() const { return _data.data(); }
+      uint8_t* data() { return _data.data(); }
+      constexpr size_t size() const { return Size; }
+      std::array<uint8_t, Size> extract_as_byte_array() const { return _data; }
+      friend bool operator==(const fixed_bytes& a, const fixed_bytes& b) { return a._data == b._data; }
+      friend bool operator!=(const fixed_bytes& a, const fixed_bytes& b) { return a._data != b._data; }
+      friend bool operator<(const fixed_bytes& a, const fixed_bytes& b) { return a._data < b._data; }
+      std::array<uint8_t, Size> _data;
+   };
+   using checksum160 = fixed_bytes<20>;
+   using checksum256 = fixed_bytes<32>;
+   using checksum512 = fixed_bytes<64>;
+
+   // not a real hash, only stable and well mixed enough for tests that compare digests
+   inline checksum256 sha256(const char* data, uint32_t length) {
+      checksum256 r;
+      uint64_t h = 1469598103934665603ull;
+      for (int round = 0; round < 4; ++round) {
+         for (uint32_t i = 0; i < length; ++i) { h ^= (uint8_t)data[i]; h *= 1099511628211ull; }
+         h ^= round;
+         h *= 1099511628211ull;
+         std::memcpy(r.data() + round * 8, &h, 8);
+      }
+      return r;
+   }
+   inline void assert_sha256(const char* data, uint32_t length, const checksum256& hash) {
+      check(sha256(data, length) == hash, "hash mismatch");
+   }
+
+   // ------------------------------------------------------------------ serialization
+
+   namespace mock { namespace refl {
+      struct any_t {
+         template <typename U> operator U() const;
+      };
+      template <typename T, typename Seq, typename = void>
+      struct brace_constructible : std::false_type {};
+      template <typename T, std::size_t... I>
+      struct brace_constructible<T, std::index_sequence<I...>, std::void_t<decltype(T{ (void(I), any_t{})... })>> : std::true_type {};
+
+      template <typename T, std::size_t N>
+      constexpr std::size_t field_count() {
+         if constexpr (N == 0) {
+            return 0;
+         } else if constexpr (brace_constructible<T, std::make_index_sequence<N>>::value) {
+            return N;
+         } else {
+            return field_count<T, N - 1>();
+         }
+      }
+   }}
+}
+
+#include "detail_refl.hpp"
+
+namespace eosio {
+   namespace mock {
+      template <typename T, typename = void>
+      struct has_mock_reflect : std::false_type {};
+      template <typename T>
+      struct has_mock_reflect<T, std::void_t<decltype(std::declval<T&>().mock_reflect(std::declval<void (*)(int&)>()))>> : std::true_type {};
+
+      template <typename T, typename F>
+      void for_each_field(T& t, F&& f) {
+         using U = std::remove_const_t<T>;
+         if constexpr (has_mock_reflect<U>::value) {
+            const_cast<U&>(t).mock_reflect(f);
+         } else {
+            static_assert(std::is_aggregate_v<U>, "type is neither an aggregate nor uses EOSLIB_SERIALIZE");
+            refl::visit_n(const_cast<U&>(t), f, std::integral_constant<std::size_t, refl::field_count<U, 48>()>{});
+         }
+      }
+
+      struct writer {
+         std::vector<char> buf;
+         void write(const void* p, size_t n) { auto c = (const char*)p; buf.insert(buf.end(), c, c + n); }
+      };
+      struct reader {
+         const char* pos;
+         const char* end;
+         void read(void* p, size_t n) {
+            check(size_t(end - pos) >= n, "read");
+            std::memcpy(p, pos, n);
+            pos += n;
+         }
+      };
+
+      template <typename T> struct is_vector : std::false_type {};
+      template <typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type {};
+      template <typename T> struct is_optional : std::false_type {};
+      template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+      template <typename T> struct is_tuple : std::false_type {};
+      template <typename... T> struct is_tuple<std::tuple<T...>> : std::true_type {};
+      template <typename T> struct is_pair : std::false_type {};
+      template <typename A, typename B> struct is_pair<std::pair<A, B>> : std::true_type {};
+      template <typename T> struct is_map : std::false_type {};
+      template <typename K, typename V, typename C, typename A> struct is_map<std::map<K, V, C, A>> : std::true_type {};
+      template <typename T> struct is_set : std::false_type {};
+      template <typename K, typename C, typename A> struct is_set<std::set<K, C, A>> : std::true_type {};
+      template <typename T> struct is_array : std::false_type {};
+      template <typename T, size_t N> struct is_array<std::array<T, N>> : std::true_type {};
+      template <typename T> struct is_fixed_bytes : std::false_type {};
+      template <size_t N> struct is_fixed_bytes<fixed_bytes<N>> : std::true_type {};
+
+      inline void pack_varuint(writer& w, uint64_t v) {
+         do {
+            uint8_t b = uint8_t(v) & 0x7f;
+            v >>= 7;
+            b |= ((v > 0) << 7);
+            w.write(&b, 1);
+         } while (v);
+      }
+      inline uint64_t unpack_varuint(reader& r) {
+         uint64_t v = 0;
+         uint8_t b = 0;
+         uint8_t by = 0;
+         do {
+            r.read(&b, 1);
+            v |= uint64_t(uint8_t(b) & 0x7f) << by;
+            by += 7;
+         } while (uint8_t(b) & 0x80);
+         return v;
+      }
+
+      template <typename T> void pack(writer& w, const T& v);
+      template <typename T> void unpack(reader& r, T& v);
+
+      template <typename T>
+      void pack(writer& w, const T& v) {
+         if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, uint128_t> || std::is_same_v<T, int128_t>) {
+            w.write(&v, sizeof(T));
+         } else if constexpr (std::is_same_v<T, name>) {
+            w.write(&v.value, 8);
+         } else if constexpr (std::is_same_v<T, symbol> || std::is_same_v<T, symbol_code>) {
+            uint64_t r = v.raw();
+            w.write(&r, 8);
+         } else if constexpr (std::is_same_v<T, asset>) {
+            pack(w, v.amount);
+            pack(w, v.symbol);
+         } else if constexpr (std::is_same_v<T, time_point>) {
+            int64_t c = v.time_since_epoch().count();
+            w.write(&c, 8);
+         } else if constexpr (std::is_same_v<T, time_point_sec>) {
+            w.write(&v.utc_seconds, 4);
+         } else if constexpr (std::is_same_v<T, block_timestamp>) {
+            w.write(&v.slot, 4);
+         } else if constexpr (std::is_same_v<T, microseconds>) {
+            w.write(&v._count, 8);
+         } else if constexpr (is_fixed_bytes<T>::value) {
+            w.write(v.data(), v.size());
+         } else if constexpr (std::is_same_v<T, std::string>) {
+            pack_varuint(w, v.size());
+            w.write(v.data(), v.size());
+         } else if constexpr (is_vector<T>::value || is_set<T>::value || is_map<T>::value) {
+            pack_varuint(w, v.size());
+            for (const auto& e : v) pack(w, e);
+         } else if constexpr (is_array<T>::value) {
+            for (const auto& e : v) pack(w, e);
+         } else if constexpr (is_optional<T>::value) {
+            pack(w, bool(v.has_value()));
+            if (v) pack(w, *v);
+         } else if constexpr (is_pair<T>::value) {
+            pack(w, v.first);
+            pack(w, v.second);
+         } else if constexpr (is_tuple<T>::value) {
+            std::apply([&](const auto&... e) { (pack(w, e), ...); }, v);
+         } else {
+            for_each_field(v, [&](auto& f) { pack(w, f); });
+         }
+      }
+
+      template <typename T>
+      void unpack(reader& r, T& v) {
+         if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, uint128_t> || std::is_same_v<T, int128_t>) {
+            r.read(&v, sizeof(T));
+         } else if constexpr (std::is_same_v<T, name>) {
+            r.read(&v.value, 8);
+         } else if constexpr (std::is_same_v<T, symbol> || std::is_same_v<T, symbol_code>) {
+            uint64_t raw;
+            r.read(&raw, 8);
+            v = T(raw);
+         } else if constexpr (std::is_same_v<T, asset>) {
+            unpack(r, v.amount);
+            unpack(r, v.symbol);
+         } else if constexpr (std::is_same_v<T, time_point>) {
+            int64_t c;
+            r.read(&c, 8);
+            v = time_point(microseconds(c));
+         } else if constexpr (std::is_same_v<T, time_point_sec>) {
+            r.read(&v.utc_seconds, 4);
+         } else if constexpr (std::is_same_v<T, block_timestamp>) {
+            r.read(&v.slot, 4);
+         } else if constexpr (std::is_same_v<T, microseconds>) {
+            r.read(&v._count, 8);
+         } else if constexpr (is_fixed_bytes<T>::value) {
+            r.read(v.data(), v.size());
+         } else if constexpr (std::is_same_v<T, std::string>) {
+            auto n = unpack_varuint(r);
+            v.resize(n);
+            r.read(v.data(), n);
+         } else if constexpr (is_vector<T>::value) {
+            auto n = unpack_varuint(r);
+            v.resize(n);
+            for (auto& e : v) unpack(r, e);
+         } else if constexpr (is_set<T>::value) {
+            auto n = unpack_varuint(r);
+            v.clear();
+            for (uint64_t i = 0; i < n; ++i) { typename T::value_type e; unpack(r, e); v.insert(e); }
+         } else if constexpr (is_map<T>::value) {
+            auto n = unpack_varuint(r);
+            v.clear();
+            for (uint64_t i = 0; i < n; ++i) {
+               typename T::key_type k; typename T::mapped_type m;
+               unpack(r, k); unpack(r, m);
+               v.emplace(std::move(k), std::move(m));
+            }
+         } else if constexpr (is_array<T>::value) {
+            for (auto& e : v) unpack(r, e);
+         } else if constexpr (is_optional<T>::value) {
+            bool has = false;
+            unpack(r, has);
+            if (has) { typename T::value_type e; unpack(r, e); v = std::move(e); } else { v.reset(); }
+         } else if constexpr (is_pair<T>::value) {
+            unpack(r, v.first);
+            unpack(r, v.second);
+         } else if constexpr (is_tuple<T>::value) {
+            std::apply([&](auto&... e) { (unpack(r, e), ...); }, v);
+         } else {
+            for_each_field(v, [&](auto& f) { unpack(r, f); });
+         }
+      }
+
+      template <typename T>
+      std::vector<char> pack(const T& v) {
+         writer w;
+         pack(w, v);
+         return std::move(w.buf);
+      }
+
+      template <typename T>
+      size_t pack_size(const T& v) {
+         writer w;
+         pack(w, v);
+         return w.buf.size();
+      }
+
+      template <typename T>
+      T unpack(const std::vector<char>& data) {
+         T v{};
+         reader r{data.data(), data.data() + data.size()};
+         unpack(r, v);
+         return v;
+      }
+   }
+
+   template <typename T>
+   size_t pack_size(const T& v) { return mock::pack_size(v); }
+
+   template <typename T>
+   std::vector<char> pack(const T& v) { return mock::pack(v); }
+
+   template <typename T>
+   class datastream {
+   public:
+      datastream(T start, size_t s) : _start(start), _pos(start), _end(start + s) {}
+      size_t remaining() const { return _end - _pos; }
+      T pos() const { return _pos; }
+   private:
+      T _start;
+      T _pos;
+      T _end;
+   };
+
+   // ------------------------------------------------------------------ print
+
+   namespace mock {
+      inline void print_one(const char* s) { out() << s; }
+      inline void print_one(const std::string& s) { out() << s; }
+      inline void print_one(std::string_view s) { out() << s; }
+      inline void print_one(bool b) { out() << (b ? "true" : "false"); }
+      inline void print_one(char c) { out() << c; }
+      inline void print_one(uint128_t v) {
+         std::string s;
+         if (v == 0) s = "0";
+         while (v) { s.insert(s.begin(), char('0' + int(v % 10))); v /= 10; }
+         out() << s;
+      }
+      inline void print_one(int128_t v) {
+         if (v < 0) { out() << "-"; print_one(uint128_t(-v)); } else print_one(uint128_t(v));
+      }
+      template <typename T>
+      void print_one(const T& v) {
+         if constexpr (std::is_arithmetic_v<T>) {
+            out() << v;
+         } else if constexpr (std::is_enum_v<T>) {
+            out() << static_cast<std::underlying_type_t<T>>(v);
+         } else {
+            v.print();
+         }
+      }
+   }
+
+   template <typename... Args>
+   void print(Args&&... args) {
+      if (!mock::print_enabled()) return;
+      (mock::print_one(std::forward<Args>(args)), ...);
+   }
+   inline void printhex(const void* data, uint32_t len) {
+      if (!mock::print_enabled()) return;
+      auto p = (const uint8_t*)data;
+      for (uint32_t i = 0; i < len; ++i) {
+         static const char* h = "0123456789abcdef";
+         mock::out() << h[p[i] >> 4] << h[p[i] & 15];
+      }
+   }
+}
+
+#define EOSIO_MOCK_CAT_I(a, b) a##b
+#define EOSIO_MOCK_CAT(a, b) EOSIO_MOCK_CAT_I(a, b)
+#define EOSIO_MOCK_FIELD_A(x) _mock_f(x); EOSIO_MOCK_FIELD_B
+#define EOSIO_MOCK_FIELD_B(x) _mock_f(x); EOSIO_MOCK_FIELD_A
+#define EOSIO_MOCK_FIELD_A_END
+#define EOSIO_MOCK_FIELD_B_END
+#define EOSLIB_SERIALIZE(TYPE, MEMBERS) \
+   template <typename _MockF> void mock_reflect(_MockF&& _mock_f) { EOSIO_MOCK_CAT(EOSIO_MOCK_FIELD_A MEMBERS, _END) }
+
+inline constexpr eosio::name operator""_n(const char* s, std::size_t n) {
+   return eosio::name(std::string_view(s, n));
+}
+
+inline constexpr eosio::symbol_code operator""_sc(const char* s, std::size_t n) {
+   return eosio::symbol_code(std::string_view(s, n));
+}
+
+#include "detail_chain.hpp"
+#include "detail_multi_index.hpp"
+#include "detail_singleton.hpp"
@@ -0,0 +1,113 @@
+#include <eosio/eosio.hpp>
+
+#define private public
+#define apply settings_apply
+#include <seeds.settings.cpp>
+#undef apply
+#include <seeds.token.cpp>
+#undef private
+
+#include "bench.hpp"
+
+using namespace eosio;
+
+namespace {
+
+  const symbol seeds_symbol = symbol("SEEDS", 4);
+
+  uint64_t spread(uint64_t i, uint64_t n) {
+    return (i * 7919) % n;
+  }
+
+  // n users, every other one already holds SEEDS - harvest holds the supply and pays them
+  void populate_balances(uint64_t n) {
+    bench::init_settings();
+    mock::register_contract(contracts::token, &apply);
+
+    token::stats stats(contracts::token, seeds_symbol.code().raw());
+    stats.emplace(contracts::token, [&](auto & item) {
+      item.supply = asset(asset::max_amount / 2, seeds_symbol);
+      item.initial_supply = item.supply;
+      item.issuer = contracts::token;
+    });
+
+    token::accounts harvest_balance(contracts::token, contracts::harvest.value);
+    harvest_balance.emplace(contracts::harvest, [&](auto & item) {
+      item.balance = asset(asset::max_amount / 2, seeds_symbol);
+    });
+
+    token::user_tables users(contracts::accounts, contracts::accounts.value);
+    for (uint64_t i = 0; i < n; i++) {
+      name account = bench::account(i);
+      users.emplace(contracts::accounts, [&](auto & item) {
+        item.account = account;
+        item.status = "citizen"_n;
+        item.type = "individual"_n;
+      });
+      if (i % 2 == 0) {
+        token::accounts balance(contracts::token, account.value);
+        balance.emplace(account, [&](auto & item) {
+          item.balance = asset(10000, seeds_symbol);
+        });
+      }
+    }
+  }
+
+  // a user transfer - balances, limits and the history entry
+  void token_transfer(bench::state & state) {
+    uint64_t n = state.range();
+    populate_balances(n);
+
+    // give the senders something to send
+    for (uint64_t i = 0; i < n; i += 2) {
+      token::accounts balance(contracts::token, bench::account(i).value);
+      balance.modify(balance.begin(), same_payer, [&](auto & item) {
+        item.balance = asset(10000000000, seeds_symbol);
+      });
+    }
+
+    state.set_iterations(1000);
+    uint64_t i = 0;
+    for (auto _ : state) {
+      name from = bench::account(spread(i, n) / 2 * 2);
+      name to = bench::account(spread(i + 1, n));
+      bench::push(contracts::token, "transfer"_n, from, to, asset(10000, seeds_symbol), std::string(""));
+      i++;
+    }
+  }
+  BENCHMARK(token_transfer)->range(10000, 1000000);
+
+  // 200 harvest payouts, one transfer each
+  void token_payouts_transfer(bench::state & state) {
+    uint64_t n = state.range();
+    populate_balances(n);
+
+    state.set_items_processed(200);
+    for (auto _ : state) {
+      for (uint64_t i = 0; i < 200; i++) {
+        bench::push(contracts::token, "transfer"_n, contracts::harvest, bench::account(spread(i, n)), asset(12345 + i, seeds_symbol), std::string("harvest"));
+      }
+    }
+  }
+  BENCHMARK(token_payouts_transfer)->range(10000, 1000000);
+
+  // the same 200 payouts in one transfermany
+  void token_payouts_transfermany(bench::state & state) {
+    uint64_t n = state.range();
+    populate_balances(n);
+
+    std::vector<token::payout> payouts;
+    for (uint64_t i = 0; i < 200; i++) {
+      payouts.push_back(token::payout{ bench::account(spread(i, n)), asset(12345 + i, seeds_symbol) });
+    }
+
+    state.set_items_processed(payouts.size());
+    for (auto _ : state) {
+      bench::push(contracts::token, "transfermany"_n, contracts::harvest, payouts, std::string("harvest"));
+    }
+  }
+  BENCHMARK(token_payouts_transfermany)->range(10000, 1000000);
+
+}
+
+BENCHMARK_MAIN()
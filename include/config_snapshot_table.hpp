@@ -0,0 +1,144 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <contracts.hpp>
+#include <map>
+
+using eosio::name;
+using std::string;
+
+/**
+ * Config snapshot - the numeric config values without descriptions
+ *
+ * The settings contract keeps a copy of every config and configfloat value in the tables below,
+ * each row is just the key and the value. Reading a config value from here does not unpack the
+ * description string that comes with every row of the config table.
+ *
+ * Values are memoized for the rest of the action - contract memory does not outlive an action,
+ * so there is nothing to invalidate.
+ */
+
+// SCOPE settings
+#define DEFINE_CONFIG_SNAPSHOT_TABLE TABLE config_snapshot_table { \
+        name param; \
+        uint64_t value; \
+        uint64_t primary_key()const { return param.value; } \
+      };
+
+#define DEFINE_CONFIG_SNAPSHOT_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"cfgsnap"_n, config_snapshot_table> config_snapshot_tables;
+
+// SCOPE settings
+#define DEFINE_CONFIG_FLOAT_SNAPSHOT_TABLE TABLE config_float_snapshot_table { \
+        name param; \
+        double value; \
+        uint64_t primary_key()const { return param.value; } \
+      };
+
+#define DEFINE_CONFIG_FLOAT_SNAPSHOT_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"cfgfltsnap"_n, config_float_snapshot_table> config_float_snapshot_tables;
+
+namespace config_snapshot {
+
+  // reader side of the tables above - plain structs so they don't end up in the ABI of every contract
+  struct config_snapshot_table {
+    name param;
+    uint64_t value;
+    uint64_t primary_key()const { return param.value; }
+  };
+  DEFINE_CONFIG_SNAPSHOT_TABLE_MULTI_INDEX
+
+  struct config_float_snapshot_table {
+    name param;
+    double value;
+    uint64_t primary_key()const { return param.value; }
+  };
+  DEFINE_CONFIG_FLOAT_SNAPSHOT_TABLE_MULTI_INDEX
+
+  // settings config rows, only read for keys that are not in the snapshot yet (settings::initsnap)
+  struct legacy_config_table {
+    name param;
+    uint64_t value;
+    string description;
+    name impact;
+    uint64_t primary_key()const { return param.value; }
+  };
+  typedef eosio::multi_index<"config"_n, legacy_config_table> legacy_config_tables;
+
+  struct legacy_config_float_table {
+    name param;
+    double value;
+    string description;
+    name impact;
+    uint64_t primary_key()const { return param.value; }
+  };
+  typedef eosio::multi_index<"configfloat"_n, legacy_config_float_table> legacy_config_float_tables;
+
+  inline std::map<uint64_t, uint64_t> & memo() {
+    static std::map<uint64_t, uint64_t> values;
+    return values;
+  }
+
+  inline std::map<uint64_t, double> & float_memo() {
+    static std::map<uint64_t, double> values;
+    return values;
+  }
+
+  inline void not_initialized(name key) {
+    // only create the error message string in error case for efficiency
+    eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
+  }
+
+  inline uint64_t get(name key) {
+    auto & values = memo();
+    auto mitr = values.find(key.value);
+    if (mitr != values.end()) {
+      return mitr->second;
+    }
+
+    uint64_t value = 0;
+
+    config_snapshot_tables snapshot(contracts::settings, contracts::settings.value);
+    auto sitr = snapshot.find(key.value);
+    if (sitr != snapshot.end()) {
+      value = sitr->value;
+    } else {
+      legacy_config_tables config(contracts::settings, contracts::settings.value);
+      auto citr = config.find(key.value);
+      if (citr == config.end()) {
+        not_initialized(key);
+      }
+      value = citr->value;
+    }
+
+    values[key.value] = value;
+    return value;
+  }
+
+  inline double get_float(name key) {
+    auto & values = float_memo();
+    auto mitr = values.find(key.value);
+    if (mitr != values.end()) {
+      return mitr->second;
+    }
+
+    double value = 0;
+
+    config_float_snapshot_tables snapshot(contracts::settings, contracts::settings.value);
+    auto sitr = snapshot.find(key.value);
+    if (sitr != snapshot.end()) {
+      value = sitr->value;
+    } else {
+      legacy_config_float_tables config(contracts::settings, contracts::settings.value);
+      auto citr = config.find(key.value);
+      if (citr == config.end()) {
+        not_initialized(key);
+      }
+      value = citr->value;
+    }
+
+    values[key.value] = value;
+    return value;
+  }
+
+}
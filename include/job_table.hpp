@@ -0,0 +1,186 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <eosio/system.hpp>
+#include <eosio/transaction.hpp>
+
+using eosio::name;
+
+/**
+ * Jobs - batch actions that walk a table in chunks
+ *
+ * A job keeps its cursor and progress in the jobs table of the contract that runs it. Each chunk is
+ * executed by the contract's jobstep action, which picks up the cursor, runs one chunk and schedules
+ * the next chunk as a deferred transaction - one second later, like all our batch actions.
+ *
+ * One run at a time: starting a job that is still running does nothing. Every start increases the run
+ * number and a chunk only runs when its run number is the current one, so leftover chunks of an older
+ * run are dropped. The deferred sender id is derived from the job name and can't collide with the
+ * other deferred transactions of the contract.
+ *
+ * Chunk size: a contract can't see the CPU it used, but it does see when a chunk never ran - a deferred
+ * transaction that runs out of CPU is dropped and the job stops making progress. Starting a job that
+ * made no progress for stall_sec resumes it where it stopped with half the chunk size. Every chunk that
+ * goes through grows the chunk size again, up to the chunk size the job was started with.
+ *
+ * The jobs table is the job status - which run, where it is, how many rows it did, when it last moved.
+ */
+
+// SCOPE contract
+#define DEFINE_JOB_TABLE TABLE job_table { \
+        name job; \
+        name status; \
+        uint64_t run; \
+        uint128_t cursor; \
+        uint64_t arg; \
+        uint64_t chunk; \
+        uint64_t processed; \
+        uint64_t chunksize; \
+        uint64_t max_chunksize; \
+        uint64_t started; \
+        uint64_t updated; \
+        uint64_t finished; \
+        uint64_t primary_key()const { return job.value; } \
+      };
+
+#define DEFINE_JOB_TABLE_MULTI_INDEX typedef eosio::multi_index<"jobs"_n, job_table> job_tables;
+
+namespace job {
+
+  const name running = "running"_n;
+  const name done = "done"_n;
+
+  // a running job that didn't move for this long lost its next chunk
+  const uint64_t stall_sec = 60;
+
+  // deferred sender ids of job chunks are (job_sender << 64) + job name
+  const uint64_t job_sender = "job"_n.value;
+
+  // what one chunk did - where the next chunk starts, how many rows it handled, and if the job is done
+  struct progress {
+    uint128_t cursor;
+    uint64_t count;
+    bool done;
+  };
+
+  inline uint64_t now() {
+    return eosio::current_time_point().sec_since_epoch();
+  }
+
+  inline void schedule(name contract, name job, uint64_t run) {
+    eosio::action next_execution(
+      eosio::permission_level{contract, "active"_n},
+      contract,
+      "jobstep"_n,
+      std::make_tuple(job, run)
+    );
+
+    eosio::transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send((uint128_t(job_sender) << 64) + job.value, contract, true);
+  }
+
+  // starts a run of job - returns the run number, or 0 if the job is still running
+  template <typename T>
+  uint64_t start(T & jobs, name contract, name job, uint64_t chunksize, uint64_t arg = 0, uint128_t cursor = 0) {
+    eosio::check(chunksize > 0, "chunk size must be > 0");
+
+    uint64_t time = now();
+    auto jitr = jobs.find(job.value);
+
+    if (jitr == jobs.end()) {
+      jobs.emplace(contract, [&](auto & item) {
+        item.job = job;
+        item.status = running;
+        item.run = 1;
+        item.cursor = cursor;
+        item.arg = arg;
+        item.chunk = 0;
+        item.processed = 0;
+        item.chunksize = chunksize;
+        item.max_chunksize = chunksize;
+        item.started = time;
+        item.updated = time;
+        item.finished = 0;
+      });
+      return 1;
+    }
+
+    if (jitr->status == running) {
+      if (time - jitr->updated < stall_sec) {
+        return 0;
+      }
+
+      // the last chunk never ran - go on from its cursor with smaller chunks
+      jobs.modify(jitr, contract, [&](auto & item) {
+        item.chunksize = std::max(uint64_t(1), item.chunksize / 2);
+        item.updated = time;
+      });
+      return jitr->run;
+    }
+
+    jobs.modify(jitr, contract, [&](auto & item) {
+      item.status = running;
+      item.run += 1;
+      item.cursor = cursor;
+      item.arg = arg;
+      item.chunk = 0;
+      item.processed = 0;
+      item.chunksize = chunksize;
+      item.max_chunksize = chunksize;
+      item.started = time;
+      item.updated = time;
+      item.finished = 0;
+    });
+    return jitr->run;
+  }
+
+  // true while a run of job is moving - a stalled run is not, the next start resumes it
+  template <typename T>
+  bool active(T & jobs, name job) {
+    auto jitr = jobs.find(job.value);
+    return jitr != jobs.end() && jitr->status == running && now() - jitr->updated < stall_sec;
+  }
+
+  // runs one chunk of job and schedules the next one - chunk gets the job row and returns a progress
+  template <typename T, typename F>
+  void step(T & jobs, name contract, name job, uint64_t run, F chunk) {
+    auto jitr = jobs.find(job.value);
+    if (jitr == jobs.end() || jitr->status != running || jitr->run != run) {
+      return;
+    }
+
+    progress result = chunk(*jitr);
+
+    // cursor 0 means "from the beginning" - a chunk that ends on a 0 key ends the run instead of starting over
+    bool finished = result.done || result.cursor == 0;
+
+    uint64_t time = now();
+    jobs.modify(jitr, contract, [&](auto & item) {
+      item.cursor = result.cursor;
+      item.chunk += 1;
+      item.processed += result.count;
+      item.updated = time;
+      if (finished) {
+        item.status = done;
+        item.finished = time;
+      } else {
+        item.chunksize = std::min(item.max_chunksize, item.chunksize + std::max(uint64_t(1), item.max_chunksize / 8));
+      }
+    });
+
+    if (!finished) {
+      schedule(contract, job, run);
+    }
+  }
+
+  template <typename T>
+  void clear(T & jobs) {
+    auto jitr = jobs.begin();
+    while (jitr != jobs.end()) {
+      jitr = jobs.erase(jitr);
+    }
+  }
+
+}
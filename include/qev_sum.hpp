@@ -0,0 +1,60 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <utils.hpp>
+
+using eosio::name;
+
+/**
+ * Rolling qualifying volume of the last moon cycle
+ *
+ * The history contract keeps the total qualifying volume per day in its own scope of the qevs table.
+ * The sum over the last moon cycle is kept in two counters of the history sizes table: the volume and
+ * the day it was summed up for. Every transfer adds its volume to today's sum; the first transfer of a
+ * day first moves the window, subtracting the days that dropped out of it.
+ *
+ * A reader on a later day than the sum (no transfers since) moves the window the same way without
+ * writing - that reads one qevs row per day that dropped out, never more than a moon cycle of rows.
+ *
+ * A day belongs to the window of day if its timestamp is >= day - moon_cycle.
+ */
+
+namespace qev_sum {
+
+  const name volume_id = "qev.sum"_n;
+  const name day_id = "qev.sum.day"_n;
+
+  inline uint64_t window_start(uint64_t day) {
+    return day > utils::moon_cycle ? day - utils::moon_cycle : 0;
+  }
+
+  // sum of the qevs rows in the window of day, read row by row
+  template <typename T>
+  uint64_t window(T & qevs, uint64_t day) {
+    uint64_t volume = 0;
+    auto qitr = qevs.lower_bound(window_start(day));
+    while (qitr != qevs.end() && qitr->timestamp <= day) {
+      volume += qitr->qualifying_volume;
+      qitr++;
+    }
+    return volume;
+  }
+
+  // moves a sum of the window of from_day to the window of to_day - days after from_day are not added
+  template <typename T>
+  uint64_t roll(T & qevs, uint64_t volume, uint64_t from_day, uint64_t to_day) {
+    if (to_day <= from_day) return volume;
+
+    uint64_t from_start = window_start(from_day);
+    uint64_t to_start = window_start(to_day);
+    if (to_start > from_day) return 0;
+
+    auto qitr = qevs.lower_bound(from_start);
+    while (qitr != qevs.end() && qitr->timestamp < to_start) {
+      volume = volume > qitr->qualifying_volume ? volume - qitr->qualifying_volume : 0;
+      qitr++;
+    }
+    return volume;
+  }
+
+}
@@ -1,17 +1,108 @@
+#pragma once
+
 #include <eosio/eosio.hpp>
 
 using eosio::name;
 
+/**
+ * Rank boxes - a bucketed order statistic for percentile ranks
+ *
+ * Instead of walking a whole table in sorted order to find out how many entries are below a value,
+ * values are dropped into boxes and we keep counts per box. The counts are stored as a Fenwick tree
+ * (binary indexed tree), so both adding / removing a value and asking "how many values are below X"
+ * touch at most log2(num_boxes) rows - 11 rows for 2048 boxes, no matter how many entries are counted.
+ *
+ * Box layout: values below 32 each get their own box. Above that every power of 2 is split into 32 boxes,
+ * so values within ~3% of each other can end up in the same box and get the same rank.
+ *
+ * One table scope per ranked number, e.g. "planted"_n
+ */
+
 // SCOPE by name
 #define DEFINE_RANKBOX_TABLE TABLE rankbox_table { \
-        uint64_t rank; \
-        uint64_t value; \
-        uint64_t primary_key()const { return value; } \
-        uint64_t by_rank()const { return rank; } \
+        uint64_t box; \
+        uint64_t count; \
+        uint64_t primary_key()const { return box; } \
       };
 
 #define DEFINE_RANKBOX_TABLE_MULTI_INDEX \
-        typedef eosio::multi_index<"rankbox"_n, rankbox_table, \
-          indexed_by<"byrank"_n, const_mem_fun<rankbox_table, uint64_t, &rankbox_table::by_rank>> \
-        > rankbox_tables;
+        typedef eosio::multi_index<"rankbox"_n, rankbox_table> rankbox_tables;
+
+namespace rankbox {
+
+  const uint64_t mantissa_bits = 5;
+  const uint64_t exact_values = uint64_t(1) << mantissa_bits;
+  const uint64_t num_boxes = 2048;
+
+  inline uint64_t box_for(uint64_t value) {
+    if (value < exact_values) return value;
+
+    uint64_t exponent = 63 - __builtin_clzll(value);
+    uint64_t shift = exponent - mantissa_bits;
+    uint64_t mantissa = (value >> shift) & (exact_values - 1);
+
+    return exact_values + shift * exact_values + mantissa;
+  }
+
+  // add delta entries to box - box rows are created on demand
+  template <typename T>
+  void add(T & boxes, uint64_t box, int64_t delta, name payer) {
+    eosio::check(box < num_boxes, "rankbox: box out of range");
+
+    for (uint64_t i = box + 1; i <= num_boxes; i += i & (~i + 1)) {
+      auto bitr = boxes.find(i);
+      if (bitr == boxes.end()) {
+        eosio::check(delta > 0, "rankbox: removing from an empty box");
+        boxes.emplace(payer, [&](auto & item) {
+          item.box = i;
+          item.count = delta;
+        });
+      } else {
+        eosio::check(delta > 0 || bitr->count >= uint64_t(-delta), "rankbox: removing from an empty box");
+        boxes.modify(bitr, payer, [&](auto & item) {
+          item.count += delta;
+        });
+      }
+    }
+  }
+
+  // number of entries in all boxes lower than box
+  template <typename T>
+  uint64_t count_below(T & boxes, uint64_t box) {
+    uint64_t count = 0;
+
+    for (uint64_t i = box; i > 0; i -= i & (~i + 1)) {
+      auto bitr = boxes.find(i);
+      if (bitr != boxes.end()) {
+        count += bitr->count;
+      }
+    }
+
+    return count;
+  }
+
+  // number of entries in all boxes
+  template <typename T>
+  uint64_t count_all(T & boxes) {
+    return count_below(boxes, num_boxes);
+  }
+
+  template <typename T>
+  void move(T & boxes, uint64_t old_value, uint64_t new_value, name payer) {
+    uint64_t old_box = box_for(old_value);
+    uint64_t new_box = box_for(new_value);
+    if (old_box == new_box) return;
+
+    add(boxes, old_box, -1, payer);
+    add(boxes, new_box, 1, payer);
+  }
+
+  template <typename T>
+  void clear(T & boxes) {
+    auto bitr = boxes.begin();
+    while (bitr != boxes.end()) {
+      bitr = boxes.erase(bitr);
+    }
+  }
 
+}
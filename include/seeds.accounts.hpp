@@ -6,8 +6,13 @@
 #include <tables/size_table.hpp>
 #include <tables/cbs_table.hpp>
 #include <tables/user_table.hpp>
+#include <tables/userstatus_table.hpp>
+#include <tables/planted_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
+#include <config_snapshot_table.hpp>
+#include <rankbox_table.hpp>
+#include <job_table.hpp>
 #include <utils.hpp>
 
 using namespace eosio;
@@ -18,23 +23,28 @@ CONTRACT accounts : public contract {
       using contract::contract;
       accounts(name receiver, name code, datastream<const char*> ds)
         : contract(receiver, code, ds),
-          users(receiver, receiver.value),
-          refs(receiver, receiver.value),
+          planted(contracts::harvest, contracts::harvest.value),
+          accts(contracts::token, contracts::token.value),
           cbs(receiver, receiver.value),
+          refs(receiver, receiver.value),
+          refcounts(receiver, receiver.value),
           vouches(receiver, receiver.value),
           vouchtotals(receiver, receiver.value),
           reqvouch(receiver, receiver.value),
+          users(receiver, receiver.value),
+          userstatus(receiver, receiver.value),
           rep(receiver, receiver.value),
+          repdelta(receiver, receiver.value),
+          punishments(receiver, receiver.value),
           sizes(receiver, receiver.value),
-          balances(contracts::harvest, contracts::harvest.value),
+          history_sizes(contracts::history, contracts::history.value),
+          jobs(receiver, receiver.value),
+          residents(contracts::history, contracts::history.value),
+          citizens(contracts::history, contracts::history.value),
           config(contracts::settings, contracts::settings.value),
           configfloat(contracts::settings, contracts::settings.value),
-          accts(contracts::token, contracts::token.value),
-          actives(contracts::proposals, contracts::proposals.value),
           totals(contracts::history, contracts::history.value),
-          residents(contracts::history, contracts::history.value),
-          citizens(contracts::history, contracts::history.value),
-          history_sizes(contracts::history, contracts::history.value)
+          actives(contracts::proposals, contracts::proposals.value)
           {}
 
       ACTION reset();
@@ -57,6 +67,8 @@ CONTRACT accounts : public contract {
 
       ACTION subrep(name user, uint64_t amount);
 
+      ACTION addreps(std::vector<rep_change> changes);
+
       ACTION requestvouch(name account, name sponsor);
 
       ACTION vouch(name sponsor, name account);
@@ -65,10 +77,17 @@ CONTRACT accounts : public contract {
 
       ACTION rankreps();
       ACTION rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
+      ACTION applyrepdlt(uint64_t start, uint64_t chunksize);
+      ACTION initrepbox(uint64_t start, uint64_t chunksize); // MIGRATION ACTION
+      ACTION initusrstat(uint64_t start, uint64_t chunksize); // MIGRATION ACTION
+      ACTION initrefcnt(uint64_t start, uint64_t chunksize); // MIGRATION ACTION
+      ACTION initcbsbox(uint64_t start, uint64_t chunksize); // MIGRATION ACTION
 
       ACTION rankcbss();
       ACTION rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
 
+      ACTION jobstep(name job, uint64_t run);
+
       ACTION changesize(name id, int64_t delta);
 
       ACTION flag(name from, name to);
@@ -76,6 +95,7 @@ CONTRACT accounts : public contract {
       ACTION punish(name account, uint64_t points);
       ACTION pnshvouchers(name account, uint64_t points, uint64_t start);
       ACTION evaldemote(name to, uint64_t start_val, uint64_t chunk, uint64_t chunksize);
+      ACTION punishstep(name account);
 
       ACTION testresident(name user);
       ACTION testcitizen(name user);
@@ -88,6 +108,7 @@ CONTRACT accounts : public contract {
 
       ACTION testmvouch(name sponsor, name account, uint64_t reps);
       ACTION migratevouch(name start_user, name start_sponsor);
+      ACTION auditvouch(name account);
 
   private:
       symbol seeds_symbol = symbol("SEEDS", 4);
@@ -130,6 +151,26 @@ CONTRACT accounts : public contract {
       const name flag_total_scope = "flag.total"_n;
       const name flag_remove_scope = "flag.remove"_n;
 
+      // rep ranking lock - holds the time the current ranking pass started, 0 when no pass is running
+      const name rep_lock = "rep.lock"_n;
+      const uint64_t rep_lock_timeout = utils::seconds_per_hour;
+
+      const name rep_box_cursor = "rep.box.cur"_n; // accounts below this are counted in the rep rank boxes
+      const name ref_count_cursor = "ref.cnt.cur"_n; // invited accounts below this are counted in refcounts
+      const name cbs_box_cursor = "cbs.box.cur"_n; // accounts below this are counted in the cbs rank boxes
+
+      const name rank_rep_job = "rankrep"_n;
+      const name rank_cbs_job = "rankcbs"_n;
+
+      // stages of the punishment of a flagged account, in this order
+      const name punish_start = "start"_n; // rep of the account not taken yet
+      const name punish_demote = "demote"_n; // status of the account not evaluated yet
+      const name punish_vouched = "vouched"_n; // walking the vouches the account gave
+      const name punish_vouchers = "vouchers"_n; // walking the sponsors that vouched for the account
+
+      // deferred sender ids of punishment steps are (punish_sender << 64) + account
+      const uint64_t punish_sender = "punish"_n.value;
+
       void buyaccount(name account, string owner_key, string active_key);
       void check_user(name account);
       void rewards(name account, name new_status);
@@ -137,16 +178,27 @@ CONTRACT accounts : public contract {
       void refreward(name account, name new_status);
       void send_reward(name beneficiary, asset quantity);
       void updatestatus(name account, name status);
+      void set_user_status(name account, name status, name type, uint64_t timestamp);
       void _vouch(name sponsor, name account);
       void history_add_resident(name account);
       void history_add_citizen(name account);
       name find_referrer(name account);
-      void send_addrep(name user, uint64_t amount);
-      void send_subrep(name user, uint64_t amount);
       void send_to_escrow(name fromfund, name recipient, asset quantity, string memo);
       uint64_t countrefs(name user, int check_num_residents);
+      bool ref_count_ready(name invited);
+      void change_ref_count(name referrer, int64_t invited, name old_status, name new_status);
+      void change_ref_status(name invited, name old_status, name new_status);
       uint64_t rep_score(name user);
       void add_rep_item(name account, uint64_t reputation);
+      void add_rep(name account, int64_t delta);
+      void change_rep(name account, int64_t delta);
+      bool is_rep_locked();
+      void stage_rep_delta(name account, int64_t delta);
+      void send_apply_rep_delta(uint64_t chunksize);
+      void send_queue_cs(const std::vector<name> & accounts);
+      bool rep_box_ready(name account);
+      void change_rep_box(name account, uint64_t old_rep, uint64_t new_rep);
+      uint64_t rep_rank(uint64_t reputation);
       uint64_t config_get(name key);
       double config_float_get(name key);
       void size_change(name id, int delta);
@@ -157,15 +209,28 @@ CONTRACT accounts : public contract {
       uint32_t num_transactions(name account, uint32_t limit);
       void add_active (name user);
       void add_cbs(name account, int points);
-      void send_punish(name account, uint64_t points);
-      void send_eval_demote(name to);
-      void send_punish_vouchers(name account, uint64_t points);
+      void set_cbs(name account, uint64_t score);
+      bool cbs_box_ready(name account);
+      void change_cbs_box(name account, uint64_t old_score, uint64_t new_score, bool is_new);
+      uint64_t cbs_rank(uint64_t score);
+      void queue_punishment(name account, uint64_t points);
+      void send_punish_step(name account);
+      void eval_demote(name to);
       void calc_vouch_rep(name account);
+      void change_vouch_total(name account, int64_t delta);
+      void set_vouch_total(name account, uint64_t total_vouch);
+      void start_job(name job, uint64_t chunksize);
+      job::progress rank_rep_chunk(uint128_t cursor, uint64_t chunk, uint64_t processed, uint64_t chunksize);
+      job::progress rank_cbs_chunk(uint128_t cursor, uint64_t processed, uint64_t chunksize);
 
       DEFINE_USER_TABLE
 
       DEFINE_USER_TABLE_MULTI_INDEX
 
+      DEFINE_USERSTATUS_TABLE
+
+      DEFINE_USERSTATUS_TABLE_MULTI_INDEX
+
       DEFINE_REP_TABLE
 
       DEFINE_REP_TABLE_MULTI_INDEX
@@ -178,6 +243,14 @@ CONTRACT accounts : public contract {
 
       DEFINE_CBS_TABLE_MULTI_INDEX
 
+      DEFINE_RANKBOX_TABLE
+
+      DEFINE_RANKBOX_TABLE_MULTI_INDEX
+
+      DEFINE_JOB_TABLE
+
+      DEFINE_JOB_TABLE_MULTI_INDEX
+
       TABLE ref_table {
         name referrer;
         name invited;
@@ -186,6 +259,18 @@ CONTRACT accounts : public contract {
         uint64_t by_referrer()const { return referrer.value; }
       };
 
+      // referrals of a referrer and how many of the invited are residents and citizens now
+      TABLE ref_count_table {
+        name referrer;
+        uint64_t invited;
+        uint64_t residents;
+        uint64_t citizens;
+
+        uint64_t primary_key() const { return referrer.value; }
+      };
+
+      typedef eosio::multi_index<"refcounts"_n, ref_count_table> ref_count_tables;
+
       TABLE vouch_table {
         name account;
         name sponsor;
@@ -236,6 +321,30 @@ CONTRACT accounts : public contract {
 
       typedef eosio::multi_index<"flagpts"_n, flag_points_table> flag_points_tables;
 
+      // rep changes that arrive while rep is being ranked, applied once the ranking pass is done
+      TABLE rep_delta_table {
+        name account;
+        int64_t delta;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef eosio::multi_index<"repdelta"_n, rep_delta_table> rep_delta_tables;
+
+      // punishment of a flagged account, carried out by punishstep - flags that come in while the vouchers
+      // are walked are collected in pending and punished in another pass
+      TABLE punishment_table {
+        name account;
+        uint64_t points;
+        uint64_t pending;
+        name stage;
+        uint64_t cursor;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef eosio::multi_index<"punishments"_n, punishment_table> punishment_tables;
+
     DEFINE_CONFIG_TABLE
 
     DEFINE_CONFIG_TABLE_MULTI_INDEX
@@ -300,11 +409,10 @@ CONTRACT accounts : public contract {
       const_mem_fun<req_vouch_table, uint64_t, &req_vouch_table::by_sponsor>>
     > req_vouch_tables;
 
-    typedef eosio::multi_index<"balances"_n, tables::balance_table,
-        indexed_by<"byplanted"_n,
-        const_mem_fun<tables::balance_table, uint64_t, &tables::balance_table::by_planted>>
-    > balance_tables;
-    balance_tables balances;
+    DEFINE_PLANTED_TABLE
+
+    DEFINE_PLANTED_TABLE_MULTI_INDEX
+    planted_tables planted;
 
     struct [[eosio::table]] account {
       asset    balance;
@@ -316,14 +424,19 @@ CONTRACT accounts : public contract {
 
     cbs_tables cbs;
     ref_tables refs;
+    ref_count_tables refcounts;
     vouches_tables vouches;
     vouches_totals_tables vouchtotals;
     req_vouch_tables reqvouch;
     user_tables users;
+    userstatus_tables userstatus;
     rep_tables rep;
-    size_tables sizes;
+    rep_delta_tables repdelta;
+    punishment_tables punishments;
+    sized_table<size_tables> sizes;
 
     size_tables history_sizes;
+    job_tables jobs;
     resident_tables residents;
     citizen_tables citizens;
 
@@ -357,9 +470,9 @@ CONTRACT accounts : public contract {
 };
 
 EOSIO_DISPATCH(accounts, (reset)(adduser)(canresident)(makeresident)(cancitizen)(makecitizen)(update)(addref)(invitevouch)(addrep)(changesize)
-(subrep)(testsetrep)(testsetrs)(testcitizen)(testresident)(testvisitor)(testremove)(testsetcbs)
+(subrep)(addreps)(testsetrep)(testsetrs)(testcitizen)(testresident)(testvisitor)(testremove)(testsetcbs)
 (testreward)(requestvouch)(vouch)(unvouch)(pnishvouched)
-(rankreps)(rankrep)(rankcbss)(rankcbs)
-(flag)(removeflag)(punish)(pnshvouchers)(evaldemote)
-(testmvouch)(migratevouch)
+(rankreps)(rankrep)(applyrepdlt)(initrepbox)(initusrstat)(initrefcnt)(initcbsbox)(rankcbss)(rankcbs)(jobstep)
+(flag)(removeflag)(punish)(pnshvouchers)(evaldemote)(punishstep)
+(testmvouch)(migratevouch)(auditvouch)
 );
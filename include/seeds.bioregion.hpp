@@ -4,8 +4,10 @@
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/user_table.hpp>
+#include <tables/size_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
+#include <config_snapshot_table.hpp>
 
 using namespace eosio;
 using std::string;
@@ -19,6 +21,7 @@ CONTRACT bioregion : public contract {
               members(receiver, receiver.value),
               sponsors(receiver, receiver.value),
               biodelays(receiver, receiver.value),
+              sizes(receiver, receiver.value),
               users(contracts::accounts, contracts::accounts.value),
               config(contracts::settings, contracts::settings.value),
               configfloat(contracts::settings, contracts::settings.value)
@@ -48,6 +51,8 @@ CONTRACT bioregion : public contract {
 
         ACTION removebr(name bioregion);
 
+        ACTION initsizes(); // MIGRATION ACTION
+
 
         void deposit(name from, name to, asset quantity, std::string memo);
 
@@ -56,6 +61,8 @@ CONTRACT bioregion : public contract {
         
         name founder_role = name("founder");
         name admin_role = name("admin");
+
+        name bioregions_size = "bios.sz"_n;
         
 
         void auth_founder(name bioregion, name founder);
@@ -136,6 +143,10 @@ CONTRACT bioregion : public contract {
         };
         typedef eosio::multi_index <"biodelays"_n, delay_table> delay_tables;
 
+        DEFINE_SIZE_TABLE
+
+        DEFINE_SIZE_TABLE_MULTI_INDEX
+
         // External tables
 
         DEFINE_USER_TABLE
@@ -159,6 +170,7 @@ CONTRACT bioregion : public contract {
         members_tables members;
         sponsors_tables sponsors;
         delay_tables biodelays;
+        sized_table<size_tables> sizes;
 };
 
 
@@ -168,7 +180,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
   } else if (code == receiver) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(bioregion, (reset)(create)(join)(leave)(addrole)(removerole)
-          (removemember)(leaverole)(setfounder)(removebr))
+          (removemember)(leaverole)(setfounder)(removebr)(initsizes))
       }
   }
 }
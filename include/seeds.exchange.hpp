@@ -5,6 +5,7 @@
 #include <contracts.hpp>
 #include <tables.hpp>
 #include <tables/price_history_table.hpp>
+#include <tables/userstatus_table.hpp>
 
 using namespace eosio;
 using std::string;
@@ -133,6 +134,10 @@ CONTRACT exchange : public contract {
 
     DEFINE_PRICE_HISTORY_TABLE_MULTI_INDEX
 
+    DEFINE_USERSTATUS_TABLE
+
+    DEFINE_USERSTATUS_TABLE_MULTI_INDEX
+
     TABLE flags_table { 
         name param; 
         uint64_t value; 
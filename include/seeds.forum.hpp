@@ -3,8 +3,11 @@
 #include <contracts.hpp>
 #include <string>
 #include <tables/user_table.hpp>
+#include <tables/rep_table.hpp>
 #include <tables/config_table.hpp>
+#include <config_snapshot_table.hpp>
 #include <tables/size_table.hpp>
+#include <job_table.hpp>
 #include <utils.hpp>
 
 using namespace eosio;
@@ -17,12 +20,14 @@ CONTRACT forum : public contract {
             : contract(receiver, code, ds),
               postcomments(receiver, receiver.value),
               forumreps(receiver, receiver.value),
-              actives(receiver, receiver.value),
-              sizes(receiver, receiver.value),
               users(contracts::accounts, contracts::accounts.value),
-              config(contracts::settings, contracts::settings.value),
+              reps(contracts::accounts, contracts::accounts.value),
               votespower(receiver, receiver.value),
-              operations(contracts::scheduler, contracts::scheduler.value)
+              config(contracts::settings, contracts::settings.value),
+              operations(contracts::scheduler, contracts::scheduler.value),
+              actives(receiver, receiver.value),
+              sizes(receiver, receiver.value),
+              jobs(receiver, receiver.value)
               {}
         
         ACTION reset();
@@ -55,6 +60,8 @@ CONTRACT forum : public contract {
 
         ACTION deleteactive(uint64_t chunksize);
 
+        ACTION jobstep(name job, uint64_t run);
+
 
 
         ACTION testapoints ();
@@ -104,10 +111,18 @@ CONTRACT forum : public contract {
 
         DEFINE_SIZE_TABLE_MULTI_INDEX
 
+        DEFINE_JOB_TABLE
+
+        DEFINE_JOB_TABLE_MULTI_INDEX
+
         DEFINE_USER_TABLE
 
         DEFINE_USER_TABLE_MULTI_INDEX
 
+        DEFINE_REP_TABLE
+
+        DEFINE_REP_TABLE_MULTI_INDEX
+
         TABLE vote_power_table {
             name account;
             uint32_t num_votes;
@@ -159,11 +174,13 @@ CONTRACT forum : public contract {
         postcomment_tables postcomments;
         forum_rep_tables forumreps;
         user_tables users;
+        rep_tables reps;
         vote_power_tables votespower;
         config_tables config;
         operations_tables operations;
         active_tables actives;
-        size_tables sizes;
+        sized_table<size_tables> sizes;
+        job_tables jobs;
         
 
         // all these values are expected to be configured in settings
@@ -176,6 +193,10 @@ CONTRACT forum : public contract {
         const name repsize = "rep.sz"_n;
         const name activesize = "active.sz"_n;
 
+        const name rank_forum_job = "rankforum"_n;
+        const name give_rep_job = "giverep"_n;
+        const name delete_active_job = "deleteactive"_n;
+
 
         void createpostcomment(name account, uint64_t post_id, uint64_t backend_id, string url, string body);
         int vote(name account, uint64_t id, uint64_t post_id, uint64_t comment_id, int64_t points);
@@ -189,10 +210,14 @@ CONTRACT forum : public contract {
         void increase_active_users(name account);
         uint64_t get_available_points();
         void size_set(name id, uint64_t newsize);
+        void start_job(name job, uint64_t chunksize, uint64_t arg = 0, uint128_t cursor = 0);
+        job::progress rank_forum_chunk(uint128_t cursor, uint64_t current, uint64_t chunksize);
+        job::progress give_rep_chunk(uint64_t start, uint64_t chunksize, uint64_t available_points);
+        job::progress delete_active_chunk(uint64_t chunksize);
 };
 
 EOSIO_DISPATCH(forum, 
     (createpost)(createcomt)(upvotepost)(upvotecomt)(downvotepost)(downvotecomt)(reset)(onperiod)(newday)
-    (rankforums)(rankforum)(givereps)(giverep)(delteactives)(deleteactive)
+    (rankforums)(rankforum)(givereps)(giverep)(delteactives)(deleteactive)(jobstep)
     (testapoints)(testsize)
 );
@@ -7,6 +7,7 @@
 #include <utils.hpp>
 #include <tables/user_table.hpp>
 #include <tables/config_table.hpp>
+#include <config_snapshot_table.hpp>
 #include <tables/size_table.hpp>
 
 using namespace eosio;
@@ -43,7 +44,7 @@ CONTRACT gratitude : public contract {
     void sub_gratitude(name account, asset quantity);
     uint64_t get_current_volume();
     void update_stats(name from, name to, asset quantity);
-    void _transfer(name beneficiary, asset quantity, string memo);
+    void _transfer_many(const std::vector<token::payout> & payouts, string memo);
     uint64_t config_get(name key);
     void size_change(name id, int delta);
     void size_set(name id, uint64_t newsize);
@@ -97,7 +98,7 @@ CONTRACT gratitude : public contract {
     // External tables
     user_tables users;
     config_tables config;
-    size_tables sizes;
+    sized_table<size_tables> sizes;
 
     const name gratzgen = "gratz.gen"_n; // Gratitude generated per cycle setting
 };
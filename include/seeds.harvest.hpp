@@ -11,10 +11,16 @@
 #include <tables/rep_table.hpp>
 #include <tables/size_table.hpp>
 #include <tables/user_table.hpp>
+#include <tables/userstatus_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
+#include <config_snapshot_table.hpp>
 #include <tables/cbs_table.hpp>
 #include <tables/cspoints_table.hpp>
+#include <tables/planted_table.hpp>
+#include <qev_sum.hpp>
+#include <rankbox_table.hpp>
+#include <job_table.hpp>
 #include <eosio/singleton.hpp>
 #include <cmath> 
 
@@ -32,16 +38,21 @@ CONTRACT harvest : public contract {
         txpoints(receiver, receiver.value),
         cspoints(receiver, receiver.value),
         sizes(receiver, receiver.value),
-        total(receiver, receiver.value),
-        harveststat(receiver, receiver.value),
         monthlyqevs(receiver, receiver.value),
         mintrate(receiver, receiver.value),
         biocstemp(receiver, receiver.value),
+        csqueue(receiver, receiver.value),
+        jobs(receiver, receiver.value),
+        harvestindex(receiver, receiver.value),
+        harvestclaims(receiver, receiver.value),
+        harveststat(receiver, receiver.value),
         config(contracts::settings, contracts::settings.value),
         configfloat(contracts::settings, contracts::settings.value),
         users(contracts::accounts, contracts::accounts.value),
-        rep(contracts::accounts, contracts::accounts.value),
+        userstatus(contracts::accounts, contracts::accounts.value),
         cbs(contracts::accounts, contracts::accounts.value),
+        rep(contracts::accounts, contracts::accounts.value),
+        total(receiver, receiver.value),
         circulating(contracts::token, contracts::token.value),
         bioregions(contracts::bioregion, contracts::bioregion.value),
         members(contracts::bioregion, contracts::bioregion.value)
@@ -57,12 +68,18 @@ CONTRACT harvest : public contract {
 
     ACTION cancelrefund(name from, uint64_t request_id);
 
+    ACTION migrefunds(name account); // MIGRATION ACTION
+
+    ACTION claim(name from); // pays out the harvest collected by from
+
     ACTION sow(name from, name to, asset quantity);
 
     ACTION runharvest();
 
-    ACTION rankplanteds();
+    ACTION rankplanteds(); // refresh all planted ranks from the rank boxes
     ACTION rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksize);
+    ACTION initplntbox(uint64_t start, uint64_t chunksize); // MIGRATION ACTION
+    ACTION initrnksums(uint64_t chunksize); // MIGRATION ACTION
 
     ACTION calctrxpts(); // calculate transaction points // 24h interval
     ACTION calctrxpt(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
@@ -71,9 +88,10 @@ CONTRACT harvest : public contract {
     ACTION rankorgtxs(); // rank org transaction score
     ACTION ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name table);
 
-    ACTION calccss(); // calculate contribution points // 1h inteval
+    ACTION calccss(); // calculate contribution points of the queued accounts // 1h inteval
     ACTION updatecs(name account); 
     ACTION calccs(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
+    ACTION queuecs(std::vector<name> accounts); // accounts whose rep or cbs rank changed
 
     ACTION rankcss(); // rank contribution score //
     ACTION rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
@@ -81,6 +99,9 @@ CONTRACT harvest : public contract {
     ACTION rankbiocss();
     ACTION rankbiocs(uint64_t start, uint64_t chunk, uint64_t chunksize);
 
+    ACTION calcscores(); // tx points (24h), contribution score and all ranks in one job // 1h interval
+    ACTION calcscore(uint64_t stage, uint64_t start_val, uint64_t chunk, uint64_t chunksize, bool calc_tx);
+
     ACTION updatetxpt(name account);
     ACTION calctotal(uint64_t startval);
 
@@ -90,7 +111,7 @@ CONTRACT harvest : public contract {
     ACTION testupdatecs(name account, uint64_t contribution_score);
     ACTION testcspoints(name account, uint64_t contribution_points);
     
-    ACTION updtotal(); // MIGRATION ACTION
+    ACTION migbalances(uint64_t chunksize); // MIGRATION ACTION
 
     ACTION setorgtxpt(name organization, uint64_t tx_points);
 
@@ -103,6 +124,8 @@ CONTRACT harvest : public contract {
     ACTION disthvstorgs(uint64_t start, uint64_t chunksize, asset total_amount);
     ACTION disthvstbios(uint64_t start, uint64_t chunksize, asset total_amount);
 
+    ACTION jobstep(name job, uint64_t run);
+
   private:
     symbol seeds_symbol = symbol("SEEDS", 4);
     symbol test_symbol = symbol("TESTS", 4);
@@ -115,9 +138,46 @@ CONTRACT harvest : public contract {
     name sum_rank_users = "usr.rnk.sz"_n;
     name sum_rank_orgs = "org.rnk.sz"_n;
     name sum_rank_bios = "bio.rnk.sz"_n;
-    name cs_bio_size = "bio.cs.sz"_n;
+    name cs_bio_size = "bio.cs.sz"_n; // bioregions with points in the cycle that is ranked
+    name bio_cs_cycle = "bio.cs.cyc"_n; // cycle the users pass adds bioregion points to
+    name bio_cs_ready = "bio.cs.rdy"_n; // last cycle the users pass finished - ranked by rankbiocs
+    name bio_cs_count = "bio.cs.cnt"_n; // bioregions with points in the running cycle
+    name bio_cs_ranked = "bio.cs.rnkd"_n; // last cycle rankbiocs finished
+    name planted_box_cursor = "plnt.box.cur"_n; // accounts below this are counted in the planted rank boxes
+    name tx_calc_time = "txpt.calc"_n; // last time calcscores recalculated transaction points
+    name rank_sum_cursor = "rnk.sum.cur"_n; // accounts below this are counted in the user and org rank sums
+    name sum_rank_users_next = "usr.rnk.new"_n; // user rank sum rebuilt by initrnksums, swapped in when it's done
+    name sum_rank_orgs_next = "org.rnk.new"_n; // org rank sum rebuilt by initrnksums, swapped in when it's done
+    name bioregions_size = "bios.sz"_n; // counted by the bioregion contract
+    name accts_cbs_size = "cbs.sz"_n; // counted by the accounts contract
+    name accts_cbs_box_cursor = "cbs.box.cur"_n; // accounts contract - accounts below this are counted in its cbs rank boxes
+
+    const uint64_t score_stage_users = 0;
+    const uint64_t score_stage_rank_tx = 1;
+    const uint64_t score_stage_rank_org_tx = 2;
+    const uint64_t score_stage_rank_cs = 3;
+    const uint64_t score_stage_prune_bio = 4;
+    const uint64_t score_stage_rank_bio = 5;
+
+    const name rank_planted_job = "rankplanted"_n;
+    const name calc_tx_job = "calctrxpt"_n;
+    const name rank_tx_job = "ranktx"_n;
+    const name rank_org_tx_job = "rankorgtx"_n;
+    const name calc_cs_job = "calccs"_n;
+    const name rank_cs_job = "rankcs"_n;
+    const name rank_bio_job = "rankbiocs"_n;
+    const name dist_users_job = "disthvstusrs"_n;
+    const name dist_bios_job = "disthvstbios"_n;
+    const name dist_orgs_job = "disthvstorgs"_n;
+    const name rank_sums_job = "initrnksums"_n;
+    const name migrate_balances_job = "migbalances"_n;
+    const name score_job = "calcscores"_n;
+
+    // users and orgs collect their harvest share through a reward-per-rank index, see runharvest
+    const name harvest_pool_users = "users"_n;
+    const name harvest_pool_orgs = "orgs"_n;
+    const uint128_t harvest_index_precision = 1000000000000;
 
-    void init_balance(name account);
     void init_harvest_stat(name account);
     void check_user(name account);
     void check_asset(asset quantity);
@@ -128,8 +188,29 @@ CONTRACT harvest : public contract {
     void add_planted(name account, asset quantity);
     void sub_planted(name account, asset quantity);
     void change_total(bool add, asset quantity);
-    void calc_contribution_score(name account, name type);
-    void add_cs_to_bioregion(name account, uint32_t points);
+    bool planted_box_ready(name account);
+    void change_planted_box(name account, uint64_t old_amount, uint64_t new_amount);
+    uint64_t planted_rank(uint64_t amount);
+    uint64_t cbs_rank(name account, uint64_t score, uint64_t stored_rank);
+    uint64_t calc_contribution_score(name account, name type);
+    void queue_cs(name account);
+    void add_cs_to_bioregion(name account, uint64_t points);
+    void start_bio_cycle();
+    void finish_bio_cycle();
+    void clear_bio_cycle(uint64_t cycle);
+    job::progress score_chunk(uint128_t cursor, uint64_t chunksize, bool calc_tx);
+    job::progress score_users_chunk(uint64_t start_val, uint64_t chunksize, bool calc_tx);
+    job::progress rank_tx_chunk(name table, uint64_t start_val, uint64_t current, uint64_t chunksize);
+    job::progress rank_cs_chunk(uint64_t start_val, uint64_t current, uint64_t chunksize);
+    job::progress prune_bio_chunk(uint64_t cycle, uint64_t start_val, uint64_t chunksize);
+    job::progress rank_bio_chunk(uint64_t cycle, uint64_t current, uint64_t chunksize);
+    job::progress rank_planted_chunk(uint128_t start_val, uint64_t current, uint64_t chunksize);
+    job::progress calc_tx_chunk(uint64_t start_val, uint64_t chunksize);
+    job::progress calc_cs_chunk(uint64_t start_val, uint64_t chunksize);
+    job::progress dist_users_chunk(uint64_t start, uint64_t chunksize, asset total_amount);
+    job::progress dist_bios_chunk(uint64_t start, uint64_t chunksize, asset total_amount);
+    job::progress dist_orgs_chunk(uint64_t start, uint64_t chunksize, asset total_amount);
+    void start_job(name job, uint64_t chunksize, uint64_t arg = 0, uint128_t cursor = 0);
 
     void size_change(name id, int delta);
     void size_set(name id, uint64_t newsize);
@@ -137,12 +218,28 @@ CONTRACT harvest : public contract {
 
     uint64_t config_get(name key);
     double config_float_get(name key);
-    void send_distribute_harvest (name key, asset amount);
+    void send_distribute_harvest (name job, asset amount);
+    void add_harvest_index(name pool, asset amount, uint64_t sum_rank);
+    void settle_harvest(name account, name type, uint64_t rank, uint64_t new_rank);
+    void settle_harvest(name account);
+    void cs_rank_changed(name account, name type, uint64_t rank, uint64_t new_rank);
+    job::progress rank_sums_chunk(uint64_t start, uint64_t chunksize);
+    job::progress migrate_balances_chunk(uint64_t start, uint64_t chunksize);
+    void init_bio_rank_sum();
+    bool rank_sums_ready();
+    uint64_t get_bioregions_size();
     void withdraw_aux(name sender, name beneficiary, asset quantity, string memo);
+    void withdraw_many(name sender, const std::vector<token::payout> & payouts, string memo);
+    void fold_refunds(name account);
+    uint64_t vested_refund(uint64_t total, uint32_t request_time);
 
     // Contract Tables
 
-    // Migration plan - leave this data in there, but start using the planted table
+    DEFINE_JOB_TABLE
+
+    DEFINE_JOB_TABLE_MULTI_INDEX
+
+    // DEPRECATED - emptied into planted by migbalances
     TABLE balance_table {
       name account;
       asset planted;
@@ -152,6 +249,7 @@ CONTRACT harvest : public contract {
       uint64_t by_planted()const { return planted.amount; }
     };
 
+    // DEPRECATED - one row per week, folded into refundscheds by fold_refunds
     TABLE refund_table {
       uint64_t request_id;
       uint64_t refund_id;
@@ -163,21 +261,9 @@ CONTRACT harvest : public contract {
       uint64_t primary_key()const { return refund_id; }
     };
 
-    TABLE planted_table {
-      name account;
-      asset planted;
-      uint64_t rank;  
+    DEFINE_PLANTED_TABLE
 
-      uint64_t primary_key()const { return account.value; }
-      uint128_t by_planted() const { return (uint128_t(planted.amount) << 64) + account.value; } 
-      uint64_t by_rank() const { return rank; } 
-
-    };
-
-    typedef eosio::multi_index<"planted"_n, planted_table,
-      indexed_by<"byplanted"_n,const_mem_fun<planted_table, uint128_t, &planted_table::by_planted>>,
-      indexed_by<"byrank"_n,const_mem_fun<planted_table, uint64_t, &planted_table::by_rank>>
-    > planted_tables;
+    DEFINE_PLANTED_TABLE_MULTI_INDEX
 
     TABLE tx_points_table {
       name account;
@@ -203,6 +289,10 @@ CONTRACT harvest : public contract {
 
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
+    DEFINE_RANKBOX_TABLE
+
+    DEFINE_RANKBOX_TABLE_MULTI_INDEX
+
     // DEPRECATED - REMOVE ONCE APPS ARE UPDATED // 
     DEFINE_HARVEST_TABLE
     
@@ -216,6 +306,10 @@ CONTRACT harvest : public contract {
 
     DEFINE_USER_TABLE_MULTI_INDEX
 
+    DEFINE_USERSTATUS_TABLE
+
+    DEFINE_USERSTATUS_TABLE_MULTI_INDEX
+
     DEFINE_CONFIG_TABLE
 
     DEFINE_CONFIG_TABLE_MULTI_INDEX
@@ -261,6 +355,19 @@ CONTRACT harvest : public contract {
 
     typedef eosio::multi_index<"refunds"_n, refund_table> refund_tables;
 
+    // one row per unplant request, vests in 12 weekly parts - the last part also gets the remainder
+    TABLE refund_schedule_table { // scoped by account
+      uint64_t request_id;
+      asset total;
+      asset claimed;
+      asset cancelled; // replanted by cancelrefund before it vested
+      uint32_t request_time;
+
+      uint64_t primary_key()const { return request_id; }
+    };
+
+    typedef eosio::multi_index<"refundscheds"_n, refund_schedule_table> refund_schedule_tables;
+
     typedef eosio::multi_index<"balances"_n, balance_table,
         indexed_by<"byplanted"_n,
         const_mem_fun<balance_table, uint64_t, &balance_table::by_planted>>
@@ -275,6 +382,15 @@ CONTRACT harvest : public contract {
       uint64_t by_points() const { return points; }
     };
 
+    // From history contract
+    TABLE trx_points_window_table {
+      name account;
+      uint64_t points;
+      uint64_t window_start;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
     // From history contract
     TABLE qev_table { // scoped by account
       uint64_t timestamp;
@@ -302,6 +418,7 @@ CONTRACT harvest : public contract {
       uint64_t primary_key()const { return id; }
     };
 
+    // DEPRECATED - replaced by biocycle, only cleared by reset
     TABLE bioregion_cs_temporal_table {
       name bioregion;
       uint32_t points;
@@ -315,6 +432,8 @@ CONTRACT harvest : public contract {
       const_mem_fun<transaction_points_table, uint64_t, &transaction_points_table::by_points>>
     > transaction_points_tables;
 
+    typedef eosio::multi_index<"trxptwindow"_n, trx_points_window_table> trx_points_window_tables;
+
     typedef eosio::multi_index<"qevs"_n, qev_table,
       indexed_by<"byvolume"_n,
       const_mem_fun<qev_table, uint64_t, &qev_table::by_volume>>
@@ -333,6 +452,32 @@ CONTRACT harvest : public contract {
       const_mem_fun<bioregion_cs_temporal_table, uint64_t, &bioregion_cs_temporal_table::by_cs_points>>
     > bioregion_cs_temporal_tables;
 
+    // contribution points of the members of a bioregion in one scoring cycle - scoped by cycle
+    TABLE bioregion_cycle_table {
+      name bioregion;
+      uint64_t points;
+
+      uint64_t primary_key()const { return bioregion.value; }
+      uint128_t by_cs_points() const { return (uint128_t(points) << 64) + bioregion.value; }
+    };
+
+    typedef eosio::multi_index<"biocycle"_n, bioregion_cycle_table,
+      indexed_by<"bycspoints"_n,
+      const_mem_fun<bioregion_cycle_table, uint128_t, &bioregion_cycle_table::by_cs_points>>
+    > bioregion_cycle_tables;
+
+    // accounts with a changed planted, tx, cbs or rep rank - their contribution points are calculated again by calccs
+    // Only the account that planted or changed its cbs is queued. The planted and cbs ranks of the accounts whose
+    // rank box was crossed by it change too and are not queued, their contribution points catch up on the daily
+    // calc_tx pass of calcscores - they are at most 24h behind.
+    TABLE cs_queue_table {
+      name account;
+
+      uint64_t primary_key()const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"csqueue"_n, cs_queue_table> cs_queue_tables;
+
     TABLE mint_rate_table {
       uint64_t id;
       int64_t mint_rate;
@@ -344,6 +489,27 @@ CONTRACT harvest : public contract {
 
     typedef eosio::multi_index<"mintrate"_n, mint_rate_table> mint_rate_tables;
 
+    // harvest per rank point paid into a pool since the first harvest, times harvest_index_precision
+    TABLE harvest_index_table {
+      name pool;
+      uint128_t index;
+
+      uint64_t primary_key() const { return pool.value; }
+    };
+
+    typedef eosio::multi_index<"hrvstindex"_n, harvest_index_table> harvest_index_tables;
+
+    // harvest collected by an account up to index - an account without a row collected nothing yet
+    TABLE harvest_claim_table {
+      name account;
+      uint128_t index;
+      asset pending;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"hrvstclaims"_n, harvest_claim_table> harvest_claim_tables;
+
     TABLE members_table {
       name bioregion;
       name account;
@@ -363,10 +529,14 @@ CONTRACT harvest : public contract {
     planted_tables planted;
     tx_points_tables txpoints;
     cs_points_tables cspoints;
-    size_tables sizes;
+    sized_table<size_tables> sizes;
     monthly_qev_tables monthlyqevs;
     mint_rate_tables mintrate;
     bioregion_cs_temporal_tables biocstemp;
+    cs_queue_tables csqueue;
+    job_tables jobs;
+    harvest_index_tables harvestindex;
+    harvest_claim_tables harvestclaims;
 
     // DEPRECATED - remove
     typedef eosio::multi_index<"harvest"_n, harvest_table> harvest_tables;
@@ -377,6 +547,7 @@ CONTRACT harvest : public contract {
     config_tables config;
     config_float_tables configfloat;
     user_tables users;
+    userstatus_tables userstatus;
     cbs_tables cbs;
     rep_tables rep;
     total_tables total;
@@ -393,13 +564,14 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(harvest, 
           (payforcpu)(reset)
-          (unplant)(claimrefund)(cancelrefund)(sow)
-          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(calccss)(calccs)(rankcss)(rankcs)(ranktxs)(rankorgtxs)(updatecs)(rankbiocss)(rankbiocs)
-          (updatetxpt)(updtotal)(calctotal)
+          (unplant)(claimrefund)(cancelrefund)(migrefunds)(claim)(sow)
+          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(initplntbox)(initrnksums)(calccss)(calccs)(queuecs)(rankcss)(rankcs)(ranktxs)(rankorgtxs)(updatecs)(rankbiocss)(rankbiocs)(calcscores)(calcscore)
+          (updatetxpt)(migbalances)(calctotal)
           (setorgtxpt)
           (testclaim)(testupdatecs)(testcalcmqev)(testcspoints)
           (calcmqevs)(calcmintrate)
           (runharvest)(disthvstusrs)(disthvstorgs)(disthvstbios)
+          (jobstep)
         )
       }
   }
@@ -4,10 +4,14 @@
 #include <eosio/asset.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
+#include <config_snapshot_table.hpp>
 #include <tables/size_table.hpp>
+#include <job_table.hpp>
+#include <qev_sum.hpp>
 
 #include <contracts.hpp>
 #include <tables/user_table.hpp>
+#include <tables/userstatus_table.hpp>
 
 #include <cmath>
 
@@ -21,14 +25,16 @@ CONTRACT history : public contract {
         history(name receiver, name code, datastream<const char*> ds)
         : contract(receiver, code, ds),
           users(contracts::accounts, contracts::accounts.value),
-          sizes(receiver, receiver.value),
+          userstatus(contracts::accounts, contracts::accounts.value),
           residents(receiver, receiver.value),
           citizens(receiver, receiver.value),
           reputables(receiver, receiver.value),
           regens(receiver, receiver.value),
           totals(receiver, receiver.value),
+          sizes(receiver, receiver.value),
           organizations(contracts::organization, contracts::organization.value),
-          members(contracts::bioregion, contracts::bioregion.value)
+          members(contracts::bioregion, contracts::bioregion.value),
+          jobs(receiver, receiver.value)
         {}
 
         ACTION reset(name account);
@@ -56,10 +62,14 @@ CONTRACT history : public contract {
         ACTION migrateusers();
         ACTION migrateuser(uint64_t start, uint64_t transaction_id, uint64_t chunksize);
 
+        ACTION jobstep(name job, uint64_t run);
+
 
     private:
       const uint64_t regenerative_org = 2;
 
+      const name migrate_user_job = "migrateuser"_n;
+
       void check_user(name account);
       uint32_t num_transactions(name account, uint32_t limit);
       uint64_t config_get(name key);
@@ -68,7 +78,10 @@ CONTRACT history : public contract {
       uint64_t get_size(name id);
       void fire_orgtx_calc(name organization, uint128_t start_val, uint64_t chunksize, uint64_t running_total);
       bool clean_old_tx(name org, uint64_t chunksize);
+      void save_points(uint64_t id, uint64_t timestamp);
       void save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day);
+      void add_trx_points (name account, uint64_t day, int64_t points);
+      void update_trx_window (name account, uint64_t day, int64_t points);
       void send_update_txpoints (name from);
       double config_float_get(name key);
       double get_transaction_multiplier (name account, name other);
@@ -76,6 +89,7 @@ CONTRACT history : public contract {
       // migration functions
       void save_migration_user_transaction(name from, name to, asset quantity, uint64_t timestamp);
       void adjust_transactions(uint64_t id, uint64_t timestamp);
+      job::progress migrate_user_chunk(uint128_t cursor, uint64_t chunksize);
 
       TABLE citizen_table {
         uint64_t id;
@@ -191,6 +205,14 @@ CONTRACT history : public contract {
         uint64_t by_points() const { return points; }
       };
 
+      TABLE trx_points_window_table { // running sum of an account's trxpoints from window_start on
+        name account;
+        uint64_t points;
+        uint64_t window_start;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
       TABLE qev_table { // scoped by account
         uint64_t timestamp;
         uint64_t qualifying_volume;
@@ -268,6 +290,8 @@ CONTRACT history : public contract {
         const_mem_fun<transaction_points_table, uint64_t, &transaction_points_table::by_points>>
       > transaction_points_tables;
 
+      typedef eosio::multi_index<"trxptwindow"_n, trx_points_window_table> trx_points_window_tables;
+
       typedef eosio::multi_index<"qevs"_n, qev_table,
         indexed_by<"byvolume"_n,
         const_mem_fun<qev_table, uint64_t, &qev_table::by_volume>>
@@ -285,19 +309,29 @@ CONTRACT history : public contract {
       
       DEFINE_USER_TABLE_MULTI_INDEX
 
+      DEFINE_USERSTATUS_TABLE
+
+      DEFINE_USERSTATUS_TABLE_MULTI_INDEX
+
       DEFINE_SIZE_TABLE
 
       DEFINE_SIZE_TABLE_MULTI_INDEX
 
+      DEFINE_JOB_TABLE
+
+      DEFINE_JOB_TABLE_MULTI_INDEX
+
       user_tables users;
+      userstatus_tables userstatus;
       resident_tables residents;
       citizen_tables citizens;
       reputable_tables reputables;
       regenerative_tables regens;
       totals_tables totals;
-      size_tables sizes;
+      sized_table<size_tables> sizes;
       organization_tables organizations;
       members_tables members;
+      job_tables jobs;
 };
 
 EOSIO_DISPATCH(history, 
@@ -308,6 +342,6 @@ EOSIO_DISPATCH(history,
   (numtrx)
   (deldailytrx)(savepoints)
   (testtotalqev)
-  (migrateusers)(migrateuser)
+  (migrateusers)(migrateuser)(jobstep)
   (migrate)
 );
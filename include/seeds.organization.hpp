@@ -5,6 +5,9 @@
 #include <utils.hpp>
 #include <tables.hpp>
 #include <tables/config_table.hpp>
+#include <config_snapshot_table.hpp>
+#include <tables/planted_table.hpp>
+#include <job_table.hpp>
 #include <cmath> 
 
 using namespace eosio;
@@ -18,16 +21,17 @@ CONTRACT organization : public contract {
             : contract(receiver, code, ds),
               organizations(receiver, receiver.value),
               sponsors(receiver, receiver.value),
+              users(contracts::accounts, contracts::accounts.value),
+              config(contracts::settings, contracts::settings.value),
               apps(receiver, receiver.value),
               regenscores(receiver, receiver.value),
               cbsorgs(receiver, receiver.value),
               sizes(receiver, receiver.value),
-              avgvotes(receiver, receiver.value),
+              planted(contracts::harvest, contracts::harvest.value),
               refs(contracts::accounts, contracts::accounts.value),
-              users(contracts::accounts, contracts::accounts.value),
-              balances(contracts::harvest, contracts::harvest.value),
-              config(contracts::settings, contracts::settings.value),
-              totals(contracts::history, contracts::history.value)
+              avgvotes(receiver, receiver.value),
+              totals(contracts::history, contracts::history.value),
+              jobs(receiver, receiver.value)
               {}
         
         
@@ -77,6 +81,8 @@ CONTRACT organization : public contract {
 
         ACTION makeregen(name organization);
 
+        ACTION jobstep(name job, uint64_t run);
+
         ACTION makereptable(name organization);
 
         ACTION testregen(name organization);
@@ -203,6 +209,10 @@ CONTRACT organization : public contract {
 
         DEFINE_SIZE_TABLE_MULTI_INDEX
 
+        DEFINE_JOB_TABLE
+
+        DEFINE_JOB_TABLE_MULTI_INDEX
+
 
         TABLE totals_table {
             name account;
@@ -247,10 +257,9 @@ CONTRACT organization : public contract {
             uint64_t by_date() const { return date; }
         };
 
-        typedef eosio::multi_index<"balances"_n, tables::balance_table,
-            indexed_by<"byplanted"_n,
-            const_mem_fun<tables::balance_table, uint64_t, &tables::balance_table::by_planted>>
-        > balance_tables;
+        DEFINE_PLANTED_TABLE
+
+        DEFINE_PLANTED_TABLE_MULTI_INDEX
     
         typedef eosio::multi_index <"organization"_n, organization_table> organization_tables;
 
@@ -305,11 +314,12 @@ CONTRACT organization : public contract {
         app_tables apps;
         regen_score_tables regenscores;
         cbs_organization_tables cbsorgs;
-        size_tables sizes;
-        balance_tables balances;
+        sized_table<size_tables> sizes;
+        planted_tables planted;
         ref_tables refs;
         avg_vote_tables avgvotes;
         totals_tables totals;
+        job_tables jobs;
 
         const name min_planted = "org.minplant"_n;
         const name regen_score_size = "rs.sz"_n;
@@ -320,6 +330,10 @@ CONTRACT organization : public contract {
         const uint64_t reputable_org = 1;
         const uint64_t regenerative_org = 2;
 
+        const name clean_dau_job = "cleandau"_n;
+        const name rank_regen_job = "rankregen"_n;
+        const name rank_cbs_job = "rankcbsorg"_n;
+
         uint64_t get_config(name key);
         void create_account(name sponsor, name orgaccount, string fullname, string publicKey);
         void check_owner(name organization, name owner);
@@ -342,6 +356,10 @@ CONTRACT organization : public contract {
         void history_add_regenerative(name organization);
         void history_add_reputable(name organization);
         uint64_t count_transactions(name organization);
+        void start_job(name job, uint64_t chunksize, uint64_t arg = 0, uint128_t cursor = 0);
+        job::progress clean_dau_chunk(uint128_t cursor, uint64_t chunksize, uint64_t todaytimestamp);
+        job::progress rank_regen_chunk(uint128_t cursor, uint64_t current, uint64_t chunksize);
+        job::progress rank_cbs_chunk(uint64_t start, uint64_t current, uint64_t chunksize);
 };
 
 
@@ -352,7 +370,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(organization, (reset)(addmember)(removemember)(changerole)(changeowner)(addregen)
             (subregen)(create)(destroy)(refund)(appuse)(registerapp)(banapp)(cleandaus)(cleandau)
-            (rankregens)(rankregen)(rankcbsorgs)(rankcbsorg)(addcbpoints)(subcbpoints)(makeregen)
+            (rankregens)(rankregen)(rankcbsorgs)(rankcbsorg)(addcbpoints)(subcbpoints)(makeregen)(jobstep)
             (makereptable)(testregen)(testreptable)(scoreorgs)(scoretrxs))
       }
   }
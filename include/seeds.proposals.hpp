@@ -6,8 +6,11 @@
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/cspoints_table.hpp>
+#include <tables/rep_table.hpp>
 #include <tables/user_table.hpp>
 #include <tables/config_table.hpp>
+#include <config_snapshot_table.hpp>
+#include <job_table.hpp>
 #include <vector>
 #include <cmath>
 
@@ -21,14 +24,16 @@ CONTRACT proposals : public contract {
       proposals(name receiver, name code, datastream<const char*> ds)
         : contract(receiver, code, ds),
           props(receiver, receiver.value),
+          participants(receiver, receiver.value),
+          users(contracts::accounts, contracts::accounts.value),
           voice(receiver, receiver.value),
           lastprops(receiver, receiver.value),
           cycle(receiver, receiver.value),
-          participants(receiver, receiver.value),
           minstake(receiver, receiver.value),
           actives(receiver, receiver.value),
           cyclestats(receiver, receiver.value),
-          users(contracts::accounts, contracts::accounts.value)
+          sizes(receiver, receiver.value),
+          jobs(receiver, receiver.value)
           {}
 
       ACTION reset();
@@ -102,6 +107,8 @@ CONTRACT proposals : public contract {
 
       ACTION testperiod ();
 
+      ACTION jobstep(name job, uint64_t run);
+
   private:
       symbol seeds_symbol = symbol("SEEDS", 4);
       name trust = "trust"_n;
@@ -133,6 +140,9 @@ CONTRACT proposals : public contract {
       name alliance_type = "alliance"_n;
       name campaign_type = "campaign"_n;
 
+      const name update_voice_job = "updatevoice"_n;
+      const name decay_voice_job = "decayvoice"_n;
+
       void update_cycle();
       void update_voicedecay();
       uint64_t get_cycle_period_sec();
@@ -146,16 +156,20 @@ CONTRACT proposals : public contract {
       void check_citizen(name account);
       void deposit(asset quantity);
       void withdraw(name account, asset quantity, name sender, string memo);
+      void withdraw_many(name sender, const std::vector<token::payout> & payouts, string memo);
       void refund_staked(name beneficiary, asset quantity);
       void send_to_escrow(name fromfund, name recipient, asset quantity, string memo);
       void burn(asset quantity);
       void update_voice_table();
       void vote_aux(name voter, uint64_t id, uint64_t amount, name option, bool is_new, bool is_delegated);
       bool revert_vote (name voter, uint64_t id);
-      void change_rep(name beneficiary, bool passed);
+      void send_addreps(const std::vector<rep_change> & changes);
       uint64_t get_size(name id);
       void size_change(name id, int64_t delta);
       void size_set(name id, int64_t value);
+      void start_job(name job, uint64_t chunksize, uint64_t arg = 0, uint128_t cursor = 0);
+      job::progress update_voice_chunk(uint64_t start, uint64_t chunksize);
+      job::progress decay_voice_chunk(uint64_t start, uint64_t chunksize);
 
       uint64_t get_quorum(uint64_t total_proposals);
       void recover_voice(name account);
@@ -180,16 +194,7 @@ CONTRACT proposals : public contract {
       void add_voted_proposal(uint64_t proposal_id);
 
       uint64_t config_get(name key) {
-        DEFINE_CONFIG_TABLE
-        DEFINE_CONFIG_TABLE_MULTI_INDEX
-        config_tables config(contracts::settings, contracts::settings.value);
-        
-        auto citr = config.find(key.value);
-          if (citr == config.end()) { 
-          // only create the error message string in error case for efficiency
-          eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-        }
-        return citr->value;
+        return config_snapshot::get(key);
       }
 
       TABLE proposal_table {
@@ -332,6 +337,9 @@ CONTRACT proposals : public contract {
     DEFINE_SIZE_TABLE
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
+    DEFINE_JOB_TABLE
+    DEFINE_JOB_TABLE_MULTI_INDEX
+
     proposal_tables props;
     participant_tables participants;
     user_tables users;
@@ -341,6 +349,8 @@ CONTRACT proposals : public contract {
     min_stake_tables minstake;
     active_tables actives;
     cycle_stats_tables cyclestats;
+    sized_table<size_tables> sizes;
+    job_tables jobs;
 
 };
 
@@ -355,6 +365,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
         (migratevoice)(testsetvoice)(delegate)(mimicvote)(undelegate)(voteonbehalf)
         (calcvotepow)
         (migrtevotedp)(migrpass)(testperiod)(migstats)(migcycstat)(testpropquor)
+        (jobstep)
         )
       }
   }
@@ -5,6 +5,7 @@
 #include <utils.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
+#include <config_snapshot_table.hpp>
 
 using namespace eosio;
 using std::string;
@@ -16,6 +17,8 @@ CONTRACT settings : public contract {
         : contract(receiver, code, ds),
           config(receiver, receiver.value),
           configfloat(receiver, receiver.value),
+          configsnap(receiver, receiver.value),
+          configfloatsnap(receiver, receiver.value),
           contracts(receiver, receiver.value)
           {}
 
@@ -31,6 +34,8 @@ CONTRACT settings : public contract {
 
       ACTION setcontract(name contract, name account);
 
+      ACTION initsnap(); // MIGRATION ACTION
+
   private:
       const name high_impact = "high"_n;
       const name medium_impact = "med"_n;
@@ -44,9 +49,23 @@ CONTRACT settings : public contract {
 
       DEFINE_CONFIG_FLOAT_TABLE_MULTI_INDEX
 
+      DEFINE_CONFIG_SNAPSHOT_TABLE
+
+      DEFINE_CONFIG_SNAPSHOT_TABLE_MULTI_INDEX
+
+      DEFINE_CONFIG_FLOAT_SNAPSHOT_TABLE
+
+      DEFINE_CONFIG_FLOAT_SNAPSHOT_TABLE_MULTI_INDEX
+
       config_tables config;
       config_float_tables configfloat;
 
+      config_snapshot_tables configsnap;
+      config_float_snapshot_tables configfloatsnap;
+
+      void snapshot(name param, uint64_t value);
+      void snapshot_float(name param, double value);
+
       /*
       * Information for clients as to where to find our contracts
       * 
@@ -69,4 +88,4 @@ CONTRACT settings : public contract {
 
 };
 
-EOSIO_DISPATCH(settings, (reset)(configure)(setcontract)(confwithdesc)(conffloat)(conffloatdsc));
+EOSIO_DISPATCH(settings, (reset)(configure)(setcontract)(confwithdesc)(conffloat)(conffloatdsc)(initsnap));
@@ -10,6 +10,10 @@
 #include <contracts.hpp>
 #include <tables.hpp>
 #include <tables/config_table.hpp>
+#include <config_snapshot_table.hpp>
+#include <tables/userstatus_table.hpp>
+#include <tables/planted_table.hpp>
+#include <job_table.hpp>
 #include <eosio/singleton.hpp>
 
 #include <string>
@@ -37,6 +41,7 @@ namespace eosio {
          using contract::contract;
          token(name receiver, name code, datastream<const char*> ds)
             :  contract(receiver, code, ds),
+               jobs(receiver, receiver.value),
                circulating(receiver, receiver.value)
                {}
          
@@ -109,6 +114,28 @@ namespace eosio {
                         const asset&   quantity,
                         const string&  memo );
 
+         struct payout {
+            name     to;
+            asset    quantity;
+         };
+
+         /**
+          * Transfer many action.
+          *
+          * @details Pays out one token to many accounts in one action - the balance of `from` is debited once
+          * with the sum of all payouts. Only for payouts from accounts that are not users (contracts and banks):
+          * for those, transfer records no transaction stats and no history either, so none of that is done here.
+          * Recipients are notified of the transfermany action, not of a transfer.
+          *
+          * @param from - the account to transfer from, must not be a user,
+          * @param payouts - recipient and quantity of every payout, all in the same token,
+          * @param memo - the memo string to accompany all payouts.
+          */
+         [[eosio::action]]
+         void transfermany( const name&                 from,
+                            const std::vector<payout>&  payouts,
+                            const string&               memo );
+
          /**
           * Open action.
           *
@@ -178,6 +205,8 @@ namespace eosio {
          [[eosio::action]]
          void resetwhelper(uint64_t begin);
 
+         ACTION jobstep(name job, uint64_t run);
+
          ACTION updatecirc();
 
          ACTION minttst(const name& to, const asset& quantity, const string& memo);
@@ -187,6 +216,7 @@ namespace eosio {
          using retire_action = eosio::action_wrapper<"retire"_n, &token::retire>;
          using burn_action = eosio::action_wrapper<"burn"_n, &token::burn>;
          using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+         using transfermany_action = eosio::action_wrapper<"transfermany"_n, &token::transfermany>;
          using open_action = eosio::action_wrapper<"open"_n, &token::open>;
          using close_action = eosio::action_wrapper<"close"_n, &token::close>;
          using issue_action_test = eosio::action_wrapper<"minttst"_n, &token::minttst>;
@@ -234,6 +264,10 @@ namespace eosio {
             const_mem_fun<tables::user_table, uint64_t, &tables::user_table::by_reputation>>
           > user_tables;
 
+          DEFINE_USERSTATUS_TABLE
+
+          DEFINE_USERSTATUS_TABLE_MULTI_INDEX
+
          void sub_balance( const name& owner, const asset& value );
          void add_balance( const name& owner, const asset& value, const name& ram_payer );
          void update_stats( const name& from, const name& to, const asset& quantity );
@@ -242,6 +276,15 @@ namespace eosio {
          uint64_t balance_for( const name& owner );
          void check_limit_transactions(name from);
          void reset_weekly_aux(uint64_t begin);
+         job::progress reset_weekly_chunk(uint64_t begin, uint64_t chunksize);
+
+         const name reset_weekly_job = "resetweekly"_n;
+
+         DEFINE_JOB_TABLE
+
+         DEFINE_JOB_TABLE_MULTI_INDEX
+
+         job_tables jobs;
 
          TABLE circulating_supply_table {
             uint64_t id;
@@ -256,10 +299,9 @@ namespace eosio {
          circulating_supply_tables circulating;
 
          typedef eosio::multi_index<"config"_n, config_table> config_tables;
-         typedef eosio::multi_index<"balances"_n, tables::balance_table,
-         indexed_by<"byplanted"_n,
-            const_mem_fun<tables::balance_table, uint64_t, &tables::balance_table::by_planted>>
-         > balance_tables;
+         DEFINE_PLANTED_TABLE
+
+         DEFINE_PLANTED_TABLE_MULTI_INDEX
 
    };
    /** @}*/ // end of @defgroup eosiotoken eosio.token
@@ -24,13 +24,4 @@ namespace tables {
     uint64_t by_reputation()const { return reputation; }
   };
 
-  TABLE balance_table {
-      name account;
-      asset planted;
-      asset reward;
-
-      uint64_t primary_key()const { return account.value; }
-      uint64_t by_planted()const { return planted.amount; }
-  };
-
 }
\ No newline at end of file
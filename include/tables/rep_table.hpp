@@ -1,3 +1,5 @@
+#pragma once
+
 #include <eosio/eosio.hpp>
 
 using eosio::name;
@@ -17,3 +19,9 @@ using eosio::name;
           indexed_by<"byrep"_n, const_mem_fun<rep_table, uint64_t, &rep_table::by_rep>>, \
           indexed_by<"byrank"_n, const_mem_fun<rep_table, uint64_t, &rep_table::by_rank>> \
         > rep_tables;
+
+// a change of the reputation of account, accounts::addreps takes a list of these
+struct rep_change {
+  name account;
+  int64_t delta;
+};
@@ -1,4 +1,7 @@
+#pragma once
+
 #include <eosio/eosio.hpp>
+#include <map>
 
 using eosio::name;
 
@@ -9,3 +12,105 @@ using eosio::name;
       };
 
 #define DEFINE_SIZE_TABLE_MULTI_INDEX typedef eosio::multi_index<"sizes"_n, size_table> size_tables;
+
+/**
+ * Counters in a sizes table
+ *
+ * Keeps the counters touched during an action in memory and writes each changed counter once when
+ * the action ends (the contract object, and with it this member, is destroyed after the action ran).
+ * A loop that changes the same counter for every user costs one row write instead of one per user.
+ *
+ * Counters never go below 0 - a negative delta larger than the counter sets it to 0.
+ *
+ * Reads through get() see the changes made in this action. Reading the sizes table directly during
+ * the action does not, so all access to the counters goes through this class.
+ */
+template <typename T>
+class sized_table {
+  public:
+    sized_table(name code, uint64_t scope) : table(code, scope), payer(code) {}
+
+    sized_table(const sized_table &) = delete;
+    sized_table & operator=(const sized_table &) = delete;
+
+    ~sized_table() {
+      flush();
+    }
+
+    uint64_t get(name id) {
+      return load(id).value;
+    }
+
+    void change(name id, int64_t delta) {
+      auto & counter = load(id);
+      if (delta < 0 && counter.value < uint64_t(-delta)) {
+        counter.value = 0;
+      } else {
+        counter.value += delta;
+      }
+      counter.dirty = true;
+    }
+
+    void set(name id, uint64_t value) {
+      auto & counter = load(id);
+      counter.value = value;
+      counter.dirty = true;
+    }
+
+    void erase(name id) {
+      counters.erase(id.value);
+      auto sitr = table.find(id.value);
+      if (sitr != table.end()) {
+        table.erase(sitr);
+      }
+    }
+
+    void clear() {
+      counters.clear();
+      auto sitr = table.begin();
+      while (sitr != table.end()) {
+        sitr = table.erase(sitr);
+      }
+    }
+
+    void flush() {
+      for (auto & entry : counters) {
+        if (!entry.second.dirty) continue;
+
+        auto sitr = table.find(entry.first);
+        if (sitr == table.end()) {
+          table.emplace(payer, [&](auto & item) {
+            item.id = name(entry.first);
+            item.size = entry.second.value;
+          });
+        } else if (sitr->size != entry.second.value) {
+          table.modify(sitr, payer, [&](auto & item) {
+            item.size = entry.second.value;
+          });
+        }
+
+        entry.second.dirty = false;
+      }
+    }
+
+  private:
+    struct counter {
+      uint64_t value;
+      bool dirty;
+    };
+
+    counter & load(name id) {
+      auto citr = counters.find(id.value);
+      if (citr != counters.end()) {
+        return citr->second;
+      }
+
+      auto sitr = table.find(id.value);
+      uint64_t value = sitr == table.end() ? 0 : sitr->size;
+      return counters[id.value] = counter{ value, false };
+    }
+
+    T table;
+    name payer;
+    std::map<uint64_t, counter> counters;
+};
@@ -24,4 +24,4 @@ using eosio::name;
 #define DEFINE_USER_TABLE_MULTI_INDEX typedef eosio::multi_index<"users"_n, user_table, \
       indexed_by<"byreputation"_n, \
       const_mem_fun<user_table, uint64_t, &user_table::by_reputation>> \
-    > user_tables; \
+    > user_tables;
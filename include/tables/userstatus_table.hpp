@@ -0,0 +1,45 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// Fixed size copy of status and type from the users table, kept in sync by the accounts contract.
+// Hot paths that only need to know whether an account is a user, and its status or type, read this
+// instead of unpacking the whole profile.
+#define DEFINE_USERSTATUS_TABLE TABLE userstatus_table { \
+        name account; \
+        name status; \
+        name type; \
+        uint64_t timestamp; \
+\
+        uint64_t primary_key()const { return account.value; } \
+      };
+
+#define DEFINE_USERSTATUS_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"userstatus"_n, userstatus_table> userstatus_tables;
+
+namespace userstatus {
+
+  // status and type of a Seeds user, returns false if account is not a user.
+  // Users that have not been copied to userstatus yet (accounts::initusrstat) are read from users.
+  template <typename S, typename U>
+  bool find(S & statuses, U & users, name account, name & status, name & type) {
+    auto sitr = statuses.find(account.value);
+    if (sitr != statuses.end()) {
+      status = sitr->status;
+      type = sitr->type;
+      return true;
+    }
+
+    auto uitr = users.find(account.value);
+    if (uitr == users.end()) {
+      return false;
+    }
+
+    status = uitr->status;
+    type = uitr->type;
+    return true;
+  }
+
+}
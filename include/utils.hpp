@@ -1,3 +1,5 @@
+#pragma once
+
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/system.hpp>
@@ -28,11 +30,10 @@ namespace utils {
      * The correct way to solve this would be to wait until the ranking is finished, and to apply changes in reputation only once that has
      * happened. Like a manually implemented table lock. (rep or any other number we are ranking)
      * 
-     * For now that's too complex - a lock would have to be between changing reputation and ranking. Ranking could simply wait until there's no 
-     * lock but applying reputation we would have to store changes in a secondary table rep_delta, apply all changes there while rep ranking is happening
-     * and apply the delta back to the full table once rep ranking is finished.
+     * Reputation does this: accounts::rankrep sets a lock, addrep / subrep write into the repdelta table while it is held,
+     * and applyrepdlt folds the deltas back into rep once the pass is finished.
      * 
-     * The count rebalances the next time we go over it, it's a dynamic system. 
+     * The other rankings still rebalance the next time we go over them, it's a dynamic system. 
      * 
      * The cheap way to fix it is to limit rank to 99
     */
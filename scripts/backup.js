@@ -20,7 +20,7 @@ const harvestFetchData = async () => {
   const balances = await eos.getTableRows({
     code: harvest,
     scope: harvest,
-    table: 'balances',
+    table: 'planted',
     json: true,
     limit: 100
   })
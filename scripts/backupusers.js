@@ -64,7 +64,7 @@ const main = async () => {
       code: harvest,
       scope: harvest,
       table_key: "account",
-      table: 'balances',
+      table: 'planted',
       json: true,
       lower_bound: lastEntry,
       upper_bound: -1,
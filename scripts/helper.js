@@ -625,6 +625,9 @@ var permissions = [{
 }, {
   target: `${accounts.harvest.account}@execute`,
   action: 'rankbiocss'
+}, {
+  target: `${accounts.harvest.account}@execute`,
+  action: 'calcscores'
 }, {
   target: `${accounts.gratitude.account}@active`,
   actor: `${accounts.gratitude.account}@eosio.code`
@@ -0,0 +1,77 @@
+#!/usr/bin/env node
+
+// Transfer load test - local nodeos only
+//
+// Sends a batch of SEEDS transfers between the test users and reports transfers per second
+// and billed CPU. The CPU of the transfer transactions comes from their receipts - history
+// bookkeeping runs inline, so it is part of that number. Any CPU billed to history.seeds
+// outside the transfers (e.g. deferred savepoints still queued by an older contract) is read
+// from the history account's cpu usage before and after the run.
+//
+// Usage: EOSIO_NETWORK=local node scripts/loadtest.js [numTransfers] [parallel]
+
+const program = require('commander')
+const { eos, names, isLocal, initContracts } = require('./helper')
+
+const { token, history, firstuser, seconduser, thirduser, fourthuser } = names
+
+const sleep = ms => new Promise(resolve => setTimeout(resolve, ms))
+
+const cpuUsed = async (account) => {
+  const info = await eos.getAccount(account)
+  return info.cpu_limit.used
+}
+
+const run = async (numTransfers, parallel) => {
+
+  if (!isLocal()) {
+    console.log("load test only runs on local")
+    return
+  }
+
+  const contracts = await initContracts({ token })
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+
+  const historyCpuBefore = await cpuUsed(history)
+
+  let receiptCpu = 0
+  let failed = 0
+  const start = Date.now()
+
+  for (let i = 0; i < numTransfers; i += parallel) {
+    const batch = []
+    for (let j = i; j < Math.min(i + parallel, numTransfers); j++) {
+      const from = users[j % users.length]
+      const to = users[(j + 1) % users.length]
+      batch.push(
+        contracts.token.transfer(from, to, '1.0000 SEEDS', `load test ${start} ${j}`, { authorization: `${from}@active` })
+          .then(result => { receiptCpu += result.processed.receipt.cpu_usage_us })
+          .catch(err => { failed++; console.log('transfer failed: ' + err) })
+      )
+    }
+    await Promise.all(batch)
+  }
+
+  const seconds = (Date.now() - start) / 1000
+
+  // let any queued deferred transactions run
+  await sleep(3000)
+
+  const historyCpuAfter = await cpuUsed(history)
+
+  const sent = numTransfers - failed
+
+  console.log(`transfers sent:          ${sent} (${failed} failed)`)
+  console.log(`transfers per second:    ${(sent / seconds).toFixed(1)}`)
+  console.log(`transfer cpu (receipts): ${receiptCpu} us, ${(receiptCpu / sent).toFixed(0)} us per transfer`)
+  console.log(`history.seeds cpu delta: ${historyCpuAfter - historyCpuBefore} us (outside transfers)`)
+}
+
+program
+  .arguments('[numTransfers] [parallel]')
+  .description('Send transfers between the test users and report transfers per second and billed cpu')
+  .action(async function (numTransfers = 200, parallel = 4) {
+    await run(parseInt(numTransfers), parseInt(parallel))
+  })
+
+program.parse(process.argv)
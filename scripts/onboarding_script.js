@@ -422,7 +422,7 @@ const accept = async (newAccount, inviteSecret) => {
     const { rows } = await getTableRows({
         code: harvest,
         scope: harvest,
-        table: 'balances',
+        table: 'planted',
         lower_bound: newAccount,
         upper_bound: newAccount,  
         json: true
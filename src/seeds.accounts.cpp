@@ -26,6 +26,11 @@ void accounts::reset() {
     uitr = users.erase(uitr);
   }
 
+  auto usitr = userstatus.begin();
+  while (usitr != userstatus.end()) {
+    usitr = userstatus.erase(usitr);
+  }
+
   flag_points_tables flags(get_self(), flag_total_scope.value);
   auto fitr = flags.begin();
   while (fitr != flags.end()) {
@@ -53,6 +58,11 @@ void accounts::reset() {
     refitr = refs.erase(refitr);
   }
 
+  auto rcitr = refcounts.begin();
+  while (rcitr != refcounts.end()) {
+    rcitr = refcounts.erase(rcitr);
+  }
+
   auto cbsitr = cbs.begin();
   while (cbsitr != cbs.end()) {
     cbsitr = cbs.erase(cbsitr);
@@ -63,11 +73,29 @@ void accounts::reset() {
     repitr = rep.erase(repitr);
   }
 
-  auto sitr = sizes.begin();
-  while (sitr != sizes.end()) {
-    sitr = sizes.erase(sitr);
+  auto rditr = repdelta.begin();
+  while (rditr != repdelta.end()) {
+    rditr = repdelta.erase(rditr);
   }
 
+  auto pnitr = punishments.begin();
+  while (pnitr != punishments.end()) {
+    pnitr = punishments.erase(pnitr);
+  }
+
+  sizes.clear();
+
+  job::clear(jobs);
+
+  rankbox_tables rep_boxes(get_self(), "rep"_n.value);
+  rankbox::clear(rep_boxes);
+  size_set(rep_box_cursor, std::numeric_limits<uint64_t>::max());
+  size_set(ref_count_cursor, std::numeric_limits<uint64_t>::max());
+
+  rankbox_tables cbs_boxes(get_self(), "cbs"_n.value);
+  rankbox::clear(cbs_boxes);
+  size_set(cbs_box_cursor, std::numeric_limits<uint64_t>::max());
+
 }
 
 void accounts::history_add_resident(name account) {
@@ -96,15 +124,19 @@ void accounts::adduser(name account, string nickname, name type)
   auto uitr = users.find(account.value);
   check(uitr == users.end(), "existing user");
 
+  uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
+
   users.emplace(_self, [&](auto& user) {
       user.account = account;
       user.status = name("visitor");
       user.reputation = 0;
       user.type = type;
       user.nickname = nickname;
-      user.timestamp = eosio::current_time_point().sec_since_epoch();
+      user.timestamp = timestamp;
   });
 
+  set_user_status(account, name("visitor"), type, timestamp);
+
   size_change("users.sz"_n, 1);
 
 }
@@ -167,10 +199,10 @@ void accounts::_vouch(name sponsor, name account) {
         item.account = account;
         item.vouch_points = vouch_points;
       });
+
+      change_vouch_total(account, vouch_points);
     }
   }
-
-  calc_vouch_rep(account); 
 }
 
 void accounts::unvouch (name sponsor, name account) {
@@ -182,31 +214,35 @@ void accounts::unvouch (name sponsor, name account) {
 
   check(vitr != vouches_by_sponsor_account.end(), "vouch not found");
 
+  int64_t vouch_points = vitr->vouch_points;
+
   vouches_by_sponsor_account.erase(vitr);
   
-  calc_vouch_rep(account);
+  change_vouch_total(account, -vouch_points);
 }
 
 void accounts::pnishvouched (name sponsor, uint64_t start_account) {
   require_auth(get_self());
 
   uint64_t batch_size = config_get("batchsize"_n);
-  uint128_t id = uint128_t(sponsor.value) << 64;
+  uint128_t id = (uint128_t(sponsor.value) << 64) + start_account;
 
-  auto vouches_by_account = vouches.get_index<"byaccount"_n>();
   auto vouches_by_sponsor_account = vouches.get_index<"byspnsoracct"_n>();
   uint64_t count = 0;
-  uint64_t max_vouch = config_get(max_vouch_points);
 
   auto vitr = vouches_by_sponsor_account.lower_bound(id);
 
   while (vitr != vouches_by_sponsor_account.end() && vitr->sponsor == sponsor && count < batch_size) {
 
-    vouches_by_sponsor_account.modify(vitr, _self, [&](auto & item){
-      item.vouch_points = 0;
-    });
+    if (vitr->vouch_points > 0) {
+      int64_t vouch_points = vitr->vouch_points;
+
+      vouches_by_sponsor_account.modify(vitr, _self, [&](auto & item){
+        item.vouch_points = 0;
+      });
 
-    calc_vouch_rep(vitr->account);
+      change_vouch_total(vitr->account, -vouch_points);
+    }
 
     vitr++;
     count++;
@@ -228,19 +264,39 @@ void accounts::pnishvouched (name sponsor, uint64_t start_account) {
   }
 }
 
+// sums up all vouches for account again - vouch, unvouch and pnishvouched change the total by delta
 void accounts::calc_vouch_rep (name account) {
   auto vouches_by_account = vouches.get_index<"byaccount"_n>();
   auto vitr = vouches_by_account.find(account.value);
 
-  uint64_t max_vouch = config_get(max_vouch_points);
   uint64_t total_vouch = 0;
-  uint64_t total_rep = 0;
 
   while (vitr != vouches_by_account.end() && vitr->account == account) {
     total_vouch += vitr -> vouch_points;
     vitr++;
   }
 
+  set_vouch_total(account, total_vouch);
+}
+
+void accounts::change_vouch_total (name account, int64_t delta) {
+  auto vtitr = vouchtotals.find(account.value);
+  uint64_t total_vouch = vtitr == vouchtotals.end() ? 0 : vtitr->total_vouch_points;
+
+  if (delta < 0 && uint64_t(-delta) > total_vouch) {
+    total_vouch = 0;
+  } else {
+    total_vouch += delta;
+  }
+
+  set_vouch_total(account, total_vouch);
+}
+
+// stores the vouch points of account and moves its rep by the change of the capped points
+void accounts::set_vouch_total (name account, uint64_t total_vouch) {
+  uint64_t max_vouch = config_get(max_vouch_points);
+  uint64_t total_rep = 0;
+
   auto vtitr = vouchtotals.find(account.value);
   if (vtitr != vouchtotals.end()) { total_rep = vtitr->total_rep_points; }
 
@@ -250,13 +306,13 @@ void accounts::calc_vouch_rep (name account) {
   if (total_rep < total_vouch_capped) {
     
     delta = total_vouch_capped - total_rep;
-    send_addrep(account, delta);
+    add_rep(account, delta);
     total_rep += delta;
 
   } else if (total_rep > total_vouch_capped) {
 
     delta = total_rep - total_vouch_capped;
-    send_subrep(account, delta);
+    add_rep(account, -int64_t(delta));
     total_rep -= delta;
 
   }
@@ -276,22 +332,6 @@ void accounts::calc_vouch_rep (name account) {
 }
 
 
-void accounts::send_addrep(name user, uint64_t amount) {
-    action(
-      permission_level{_self, "active"_n},
-      contracts::accounts, "addrep"_n,
-      std::make_tuple(user, amount)
-  ).send();
-}
-
-void accounts::send_subrep(name user, uint64_t amount) {
-    action(
-      permission_level{_self, "active"_n},
-      contracts::accounts, "subrep"_n,
-      std::make_tuple(user, amount)
-  ).send();
-}
-
 void accounts::rewards(name account, name new_status) {
   vouchreward(account);
   refreward(account, new_status);
@@ -309,7 +349,7 @@ void accounts::vouchreward(name account) {
 
   while (vitr != vouches_by_account.end() && vitr -> account == account) {
     auto sponsor = vitr->sponsor;
-    send_addrep(sponsor, 1); // TODO: check if this has to be always 1    
+    add_rep(sponsor, 1); // TODO: check if this has to be always 1    
     vitr++;
   }
 }
@@ -357,7 +397,7 @@ void accounts::refreward(name account, name new_status) {
     // gets number of residents or citizens from the History size table
     auto size_id = is_citizen ? "citizens.sz"_n : "residents.sz"_n;
     auto sitr = history_sizes.find(size_id.value);
-    auto num_users = (sitr == sizes.end()) ? 0 : sitr->size;
+    auto num_users = (sitr == history_sizes.end()) ? 0 : sitr->size;
 
     if (user_type == "organisation"_n) 
     {
@@ -412,7 +452,7 @@ void accounts::refreward(name account, name new_status) {
       auto seeds_reward = calc_decaying_rewards(num_users, min, max, dec);
       asset quantity(seeds_reward, seeds_symbol);
 
-      send_addrep(referrer, rep_points);
+      add_rep(referrer, rep_points);
 
       send_reward(referrer, quantity);
     }
@@ -428,20 +468,66 @@ void accounts::refreward(name account, name new_status) {
 
 void accounts::add_cbs(name account, int points) {
   auto citr = cbs.find(account.value);
-  if (citr != cbs.end()) {
-    cbs.modify(citr, _self, [&](auto& item) {
-      item.community_building_score += points;
-    });
-  } else {
+  uint64_t score = citr == cbs.end() ? 0 : citr->community_building_score;
+  set_cbs(account, score + points);
+}
+
+// The rank of account is taken from the cbs rank boxes right away. The ranks of the other accounts
+// move as well - harvest reads them from the boxes, the rank field of their rows is only updated
+// when their own score changes.
+void accounts::set_cbs(name account, uint64_t score) {
+  auto citr = cbs.find(account.value);
+  bool ready = cbs_box_ready(account);
+
+  if (citr == cbs.end()) {
+    size_change("cbs.sz"_n, 1);
+    change_cbs_box(account, 0, score, true);
+    uint64_t rank = ready ? cbs_rank(score) : 0;
     cbs.emplace(_self, [&](auto& item) {
       item.account = account;
-      item.community_building_score = points;
-      item.rank = 0;
+      item.community_building_score = score;
+      item.rank = rank;
+    });
+    if (rank > 0) send_queue_cs({ account });
+  } else {
+    change_cbs_box(account, citr->community_building_score, score, false);
+    uint64_t rank = ready ? cbs_rank(score) : citr->rank;
+    if (rank != citr->rank) send_queue_cs({ account });
+    cbs.modify(citr, _self, [&](auto& item) {
+      item.community_building_score = score;
+      item.rank = rank;
     });
-    size_change("cbs.sz"_n, 1);
   }
 }
 
+bool accounts::cbs_box_ready(name account) {
+  return account.value < get_size(cbs_box_cursor);
+}
+
+// every cbs row is counted, a score of 0 in box 0 - they rank below everyone else like in the cbs table
+void accounts::change_cbs_box(name account, uint64_t old_score, uint64_t new_score, bool is_new) {
+  if (!cbs_box_ready(account)) return;
+
+  rankbox_tables cbs_boxes(get_self(), "cbs"_n.value);
+
+  if (is_new) {
+    rankbox::add(cbs_boxes, rankbox::box_for(new_score), 1, _self);
+  } else {
+    rankbox::move(cbs_boxes, old_score, new_score, _self);
+  }
+}
+
+// while initcbsbox is still filling the boxes the rank is among the accounts counted so far
+uint64_t accounts::cbs_rank(uint64_t score) {
+  rankbox_tables cbs_boxes(get_self(), "cbs"_n.value);
+
+  bool filled = get_size(cbs_box_cursor) == std::numeric_limits<uint64_t>::max();
+  uint64_t total = filled ? get_size("cbs.sz"_n) : rankbox::count_all(cbs_boxes);
+  if (total == 0) return 0;
+
+  return utils::rank(rankbox::count_below(cbs_boxes, rankbox::box_for(score)), total);
+}
+
 void accounts::addref(name referrer, name invited)
 {
   require_auth(get_self());
@@ -454,6 +540,55 @@ void accounts::addref(name referrer, name invited)
     ref.invited = invited;
   });
 
+  if (ref_count_ready(invited)) {
+    name status, type;
+    if (!userstatus::find(userstatus, users, invited, status, type)) {
+      status = not_found;
+    }
+    change_ref_count(referrer, 1, not_found, status);
+  }
+
+}
+
+bool accounts::ref_count_ready(name invited) {
+  return invited.value < get_size(ref_count_cursor);
+}
+
+// adds invited referrals to the counters of referrer and moves one invited from old_status to new_status
+void accounts::change_ref_count(name referrer, int64_t invited, name old_status, name new_status) {
+  int64_t residents = int64_t(new_status == "resident"_n) - int64_t(old_status == "resident"_n);
+  int64_t citizens = int64_t(new_status == "citizen"_n) - int64_t(old_status == "citizen"_n);
+
+  if (invited == 0 && residents == 0 && citizens == 0) return;
+
+  auto add = [](uint64_t count, int64_t delta) {
+    return delta < 0 && uint64_t(-delta) > count ? 0 : count + delta;
+  };
+
+  auto citr = refcounts.find(referrer.value);
+  if (citr == refcounts.end()) {
+    refcounts.emplace(_self, [&](auto& item) {
+      item.referrer = referrer;
+      item.invited = add(0, invited);
+      item.residents = add(0, residents);
+      item.citizens = add(0, citizens);
+    });
+  } else {
+    refcounts.modify(citr, _self, [&](auto& item) {
+      item.invited = add(item.invited, invited);
+      item.residents = add(item.residents, residents);
+      item.citizens = add(item.citizens, citizens);
+    });
+  }
+}
+
+void accounts::change_ref_status(name invited, name old_status, name new_status) {
+  if (old_status == new_status || !ref_count_ready(invited)) return;
+
+  auto ritr = refs.find(invited.value);
+  if (ritr == refs.end()) return;
+
+  change_ref_count(ritr->referrer, 0, old_status, new_status);
 }
 
 // internal vouch function
@@ -469,22 +604,10 @@ void accounts::addrep(name user, uint64_t amount)
   require_auth(get_self());
 
   check(is_account(user), "non existing user");
+  check_user(user);
   check(amount > 0, "amount must be > 0");
 
-  auto uitr = users.find(user.value);
-  users.modify(uitr, _self, [&](auto& user) {
-    user.reputation += amount;
-  });
-
-  auto ritr = rep.find(user.value);
-  if (ritr == rep.end()) {
-    add_rep_item(user, amount);
-  } else {
-    rep.modify(ritr, _self, [&](auto& item) {
-      item.rep += amount;
-    });
-  }
-
+  add_rep(user, amount);
 }
 
 void accounts::subrep(name user, uint64_t amount)
@@ -492,30 +615,115 @@ void accounts::subrep(name user, uint64_t amount)
   require_auth(get_self());
 
   check(is_account(user), "non existing user");
+  check_user(user);
   check(amount > 0, "amount must be > 0");
 
-  // modify user reputation - deprecated
-  auto uitr = users.find(user.value);
-  users.modify(uitr, _self, [&](auto& user) {
-    if (user.reputation < amount) {
-      user.reputation = 0;
+  add_rep(user, -int64_t(amount));
+}
+
+// rep changes of many sources in one action - the changes of an account are added up and applied once
+void accounts::addreps(std::vector<rep_change> changes)
+{
+  require_auth(get_self());
+
+  std::map<name, int64_t> deltas;
+  for (const auto & change : changes) {
+    deltas[change.account] += change.delta;
+  }
+
+  for (const auto & delta : deltas) {
+    if (delta.second == 0) continue;
+    check(is_account(delta.first), "non existing user " + delta.first.to_string());
+    check_user(delta.first);
+    add_rep(delta.first, delta.second);
+  }
+}
+
+// changes rep now, or after the ranking pass that holds the rep lock
+void accounts::add_rep(name account, int64_t delta) {
+  if (delta == 0) return;
+
+  if (is_rep_locked()) {
+    stage_rep_delta(account, delta);
+  } else {
+    change_rep(account, delta);
+  }
+}
+
+void accounts::change_rep(name account, int64_t delta) {
+  auto ritr = rep.find(account.value);
+
+  if (delta > 0) {
+    if (ritr == rep.end()) {
+      add_rep_item(account, delta);
     } else {
-      user.reputation -= amount;
+      change_rep_box(account, ritr->rep, ritr->rep + delta);
+      rep.modify(ritr, _self, [&](auto& item) {
+        item.rep += delta;
+      });
     }
-  });
-
-  auto ritr = rep.find(user.value);
-  if (ritr != rep.end()) {
+  } else if (delta < 0 && ritr != rep.end()) {
+    uint64_t amount = -delta;
     if (ritr->rep > amount) {
+      change_rep_box(account, ritr->rep, ritr->rep - amount);
       rep.modify(ritr, _self, [&](auto& item) {
         item.rep -= amount;
       });
     } else {
+      change_rep_box(account, ritr->rep, 0);
+      if (ritr->rank > 0) send_queue_cs({ account });
       rep.erase(ritr);
       size_change("rep.sz"_n, -1);
     }
   }
+}
+
+bool accounts::is_rep_locked() {
+  uint64_t locked_at = get_size(rep_lock);
+  if (locked_at == 0) return false;
+
+  // a ranking pass that died doesn't hold the lock forever
+  return locked_at + rep_lock_timeout > current_time_point().sec_since_epoch();
+}
+
+bool accounts::rep_box_ready(name account) {
+  return account.value < get_size(rep_box_cursor);
+}
+
+void accounts::change_rep_box(name account, uint64_t old_rep, uint64_t new_rep) {
+  if (!rep_box_ready(account)) return;
+
+  rankbox_tables rep_boxes(get_self(), "rep"_n.value);
+
+  if (old_rep > 0 && new_rep > 0) {
+    rankbox::move(rep_boxes, old_rep, new_rep, _self);
+  } else if (old_rep > 0) {
+    rankbox::add(rep_boxes, rankbox::box_for(old_rep), -1, _self);
+  } else if (new_rep > 0) {
+    rankbox::add(rep_boxes, rankbox::box_for(new_rep), 1, _self);
+  }
+}
+
+uint64_t accounts::rep_rank(uint64_t reputation) {
+  uint64_t total = get_size("rep.sz"_n);
+  if (total == 0) return 0;
 
+  rankbox_tables rep_boxes(get_self(), "rep"_n.value);
+  return utils::rank(rankbox::count_below(rep_boxes, rankbox::box_for(reputation)), total);
+}
+
+void accounts::stage_rep_delta(name account, int64_t delta) {
+  auto rditr = repdelta.find(account.value);
+  if (rditr == repdelta.end()) {
+    repdelta.emplace(_self, [&](auto& item) {
+      item.account = account;
+      item.delta = delta;
+    });
+  } else {
+    repdelta.modify(rditr, _self, [&](auto& item) {
+      item.delta += delta;
+    });
+  }
 }
 
 void accounts::update(name user, name type, string nickname, string image, string story, string roles, string skills, string interests)
@@ -537,6 +745,8 @@ void accounts::update(name user, name type, string nickname, string image, strin
       user.skills = skills;
       user.interests = interests;
     });
+
+    set_user_status(user, uitr->status, uitr->type, uitr->timestamp);
 }
 
 void accounts::send_reward(name beneficiary, asset quantity)
@@ -609,7 +819,8 @@ bool accounts::check_can_make_resident(name user) {
     check(uitr != users.end(), "no user");
     check(uitr->status == name("visitor"), "user is not a visitor");
 
-    auto bitr = balances.find(user.value);
+    auto pitr = planted.find(user.value);
+    uint64_t planted_amount = pitr == planted.end() ? 0 : pitr->planted.amount;
 
     uint64_t invited_users_number = countrefs(user, 0);
     uint64_t min_planted = config_get("res.plant"_n);
@@ -621,7 +832,7 @@ bool accounts::check_can_make_resident(name user) {
 
     uint64_t reputation_points = rep.get(user.value,  "user has less than required reputation. Actual: 0").rep;
 
-    check(bitr->planted.amount >= min_planted, "user has less than required seeds planted");
+    check(planted_amount >= min_planted, "user has less than required seeds planted");
     check(total_transactions >= min_tx, "resident: user has less than required transactions number has: "+
       std::to_string(total_transactions) + " needed: "+
       std::to_string(min_tx));
@@ -638,10 +849,14 @@ void accounts::updatestatus(name user, name status)
   check(uitr != users.end(), "updatestatus: user not found - " + user.to_string());
   check(uitr->type == individual, "updatestatus: Only individuals can become residents or citizens");
 
+  change_ref_status(user, uitr->status, status);
+
   users.modify(uitr, _self, [&](auto& user) {
     user.status = status;
   });
 
+  set_user_status(user, status, uitr->type, uitr->timestamp);
+
   bool trust = status == name("citizen");
 
   action(
@@ -653,21 +868,11 @@ void accounts::updatestatus(name user, name status)
 }
 
 uint64_t accounts::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    // only create the error message string in error case for efficiency
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get(key);
 }
 
 double accounts::config_float_get (name key) {
-  auto fitr = configfloat.find(key.value);
-  if (fitr == configfloat.end()) { 
-    // only create the error message string in error case for efficiency
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return fitr->value;
+  return config_snapshot::get_float(key);
 }
 
 void accounts::cancitizen(name user) {
@@ -696,7 +901,8 @@ bool accounts::check_can_make_citizen(name user) {
     check(uitr != users.end(), "no user");
     check(uitr->status == name("resident"), "user is not a resident");
 
-    auto bitr = balances.find(user.value);
+    auto pitr = planted.find(user.value);
+    uint64_t planted_amount = pitr == planted.end() ? 0 : pitr->planted.amount;
 
     uint64_t min_planted = config_get("cit.plant"_n);
     uint64_t min_tx = config_get("cit.tx"_n);
@@ -710,7 +916,7 @@ bool accounts::check_can_make_citizen(name user) {
 
     uint64_t total_transactions = num_transactions(user, min_tx);
 
-    check(bitr->planted.amount >= min_planted, "user has less than required seeds planted");
+    check(planted_amount >= min_planted, "user has less than required seeds planted");
     check(total_transactions >= min_tx, "user has less than required transactions number has: "+
       std::to_string(total_transactions) + " needed: "+
       std::to_string(min_tx));
@@ -778,105 +984,393 @@ uint32_t accounts::num_transactions(name account, uint32_t limit) {
 }
 
 void accounts::rankreps() {
-  rankrep(0, 0, 200);
+  start_job(rank_rep_job, 200);
 }
 
+// starts a ranking pass with chunksize - the cursor arguments are left from before jobs and not used
 void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(_self);
+  start_job(rank_rep_job, chunksize);
+}
+
+void accounts::start_job(name job, uint64_t chunksize) {
+  uint64_t run = job::start(jobs, get_self(), job, chunksize);
+  if (run > 0) {
+    jobstep(job, run);
+  }
+}
+
+void accounts::jobstep(name job, uint64_t run) {
+  require_auth(_self);
 
+  job::step(jobs, get_self(), job, run, [&](const auto & item) {
+    if (job == rank_rep_job) {
+      return rank_rep_chunk(item.cursor, item.chunk, item.processed, item.chunksize);
+    }
+    if (job == rank_cbs_job) {
+      return rank_cbs_chunk(item.cursor, item.processed, item.chunksize);
+    }
+    check(false, "unknown job " + job.to_string());
+    return job::progress{ 0, 0, true };
+  });
+}
+
+job::progress accounts::rank_rep_chunk(uint128_t cursor, uint64_t chunk, uint64_t processed, uint64_t chunksize) {
   uint64_t total = get_size("rep.sz"_n);
-  if (total == 0) return;
+  if (total == 0) {
+    size_set(rep_lock, 0);
+    return job::progress{ 0, 0, true };
+  }
 
-  uint64_t current = chunk * chunksize;
+  if (chunk == 0) {
+    // rep changes go to repdelta until the pass is done, so all chunks rank the same snapshot
+    size_set(rep_lock, current_time_point().sec_since_epoch());
+  }
+
+  uint64_t current = processed;
   auto rep_by_rep = rep.get_index<"byrep"_n>();
-  auto ritr = start_val == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(start_val);
+  auto ritr = cursor == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(uint64_t(cursor));
   uint64_t count = 0;
+  std::vector<name> changed;
 
   while (ritr != rep_by_rep.end() && count < chunksize) {
 
     uint64_t rank = utils::rank(current, total);
 
-    rep_by_rep.modify(ritr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (ritr->rank != rank) {
+      rep_by_rep.modify(ritr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      changed.push_back(ritr->account);
+    }
 
     current++;
     count++;
     ritr++;
   }
 
+  send_queue_cs(changed);
+
   if (ritr == rep_by_rep.end()) {
     // Done.
-  } else {
-    // recursive call
-    uint64_t next_value = ritr->by_rep();
+    size_set(rep_lock, 0);
+    if (repdelta.begin() != repdelta.end()) {
+      send_apply_rep_delta(chunksize);
+    }
+    return job::progress{ 0, count, true };
+  }
+
+  return job::progress{ ritr->by_rep(), count, false };
+}
+
+// harvest calculates the contribution points of these accounts again on its next pass
+void accounts::send_queue_cs(const std::vector<name> & accounts) {
+  if (accounts.empty()) return;
+
+  action(
+    permission_level{get_self(), "active"_n},
+    contracts::harvest,
+    "queuecs"_n,
+    std::make_tuple(accounts)
+  ).send();
+}
+
+void accounts::send_apply_rep_delta(uint64_t chunksize) {
+  action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "applyrepdlt"_n,
+      std::make_tuple(uint64_t(0), chunksize)
+  );
+
+  cancel_deferred(rep_lock.value);
+
+  transaction tx;
+  tx.actions.emplace_back(next_execution);
+  tx.delay_sec = 1;
+  tx.send(rep_lock.value, _self);
+}
+
+void accounts::applyrepdlt(uint64_t start, uint64_t chunksize) {
+  require_auth(_self);
+
+  // a new ranking pass started - it applies the deltas when it's done
+  if (is_rep_locked()) return;
+
+  auto rditr = start == 0 ? repdelta.begin() : repdelta.lower_bound(start);
+  uint64_t count = 0;
+
+  while (rditr != repdelta.end() && count < chunksize) {
+    change_rep(rditr->account, rditr->delta);
+    rditr = repdelta.erase(rditr);
+    count++;
+  }
+
+  if (rditr != repdelta.end()) {
+    uint64_t next_value = rditr->account.value;
     action next_execution(
         permission_level{get_self(), "active"_n},
         get_self(),
-        "rankrep"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
+        "applyrepdlt"_n,
+        std::make_tuple(next_value, chunksize)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(next_value + 1, _self);
-    
+    tx.send(rep_lock.value, _self);
+  }
+}
+
+void accounts::initrepbox(uint64_t start, uint64_t chunksize) {
+  require_auth(_self);
+
+  check(chunksize > 0, "chunk size must be > 0");
+
+  rankbox_tables rep_boxes(get_self(), "rep"_n.value);
+
+  if (start == 0) {
+    rankbox::clear(rep_boxes);
   }
 
+  auto ritr = start == 0 ? rep.begin() : rep.lower_bound(start);
+  uint64_t count = 0;
+
+  // collect per box first so each box is only written once per chunk
+  std::map<uint64_t, int64_t> box_counts;
+
+  while (ritr != rep.end() && count < chunksize) {
+    if (ritr->rep > 0) {
+      box_counts[rankbox::box_for(ritr->rep)]++;
+    }
+    count++;
+    ritr++;
+  }
+
+  for (auto & box_count : box_counts) {
+    rankbox::add(rep_boxes, box_count.first, box_count.second, _self);
+  }
+
+  if (ritr == rep.end()) {
+    size_set(rep_box_cursor, std::numeric_limits<uint64_t>::max());
+  } else {
+    uint64_t next_value = ritr->account.value;
+    size_set(rep_box_cursor, next_value);
+
+    action next_execution(
+        permission_level{get_self(), "active"_n},
+        get_self(),
+        "initrepbox"_n,
+        std::make_tuple(next_value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(rep_box_cursor.value, _self);
+  }
 }
 
-void accounts::rankcbss() {
-  rankcbs(0, 0, 200);
+void accounts::initusrstat(uint64_t start, uint64_t chunksize) {
+  require_auth(_self);
+
+  check(chunksize > 0, "chunk size must be > 0");
+
+  auto uitr = start == 0 ? users.begin() : users.lower_bound(start);
+  uint64_t count = 0;
+
+  while (uitr != users.end() && count < chunksize) {
+    set_user_status(uitr->account, uitr->status, uitr->type, uitr->timestamp);
+    count++;
+    uitr++;
+  }
+
+  if (uitr != users.end()) {
+    action next_execution(
+        permission_level{get_self(), "active"_n},
+        get_self(),
+        "initusrstat"_n,
+        std::make_tuple(uitr->account.value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send("initusrstat"_n.value, _self);
+  }
 }
 
-void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
+void accounts::initrefcnt(uint64_t start, uint64_t chunksize) {
   require_auth(_self);
 
-  uint64_t total = get_size("cbs.sz"_n);
-  if (total == 0) return;
+  check(chunksize > 0, "chunk size must be > 0");
 
-  uint64_t current = chunk * chunksize;
-  auto cbs_by_cbs = cbs.get_index<"bycbs"_n>();
-  auto citr = start_val == 0 ? cbs_by_cbs.begin() : cbs_by_cbs.lower_bound(start_val);
+  if (start == 0) {
+    auto citr = refcounts.begin();
+    while (citr != refcounts.end()) {
+      citr = refcounts.erase(citr);
+    }
+  }
+
+  auto ritr = start == 0 ? refs.begin() : refs.lower_bound(start);
   uint64_t count = 0;
 
-  while (citr != cbs_by_cbs.end() && count < chunksize) {
+  struct counts { int64_t invited = 0; int64_t residents = 0; int64_t citizens = 0; };
 
-    uint64_t rank = utils::rank(current, total);
+  // collect per referrer first so each counter is only written once per chunk
+  std::map<name, counts> ref_counts;
 
-    cbs_by_cbs.modify(citr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+  while (ritr != refs.end() && count < chunksize) {
+    auto & c = ref_counts[ritr->referrer];
+    c.invited++;
 
-    current++;
+    name status, type;
+    if (userstatus::find(userstatus, users, ritr->invited, status, type)) {
+      if (status == "resident"_n) c.residents++;
+      if (status == "citizen"_n) c.citizens++;
+    }
+    count++;
+    ritr++;
+  }
+
+  for (auto & ref_count : ref_counts) {
+    auto citr = refcounts.find(ref_count.first.value);
+    if (citr == refcounts.end()) {
+      refcounts.emplace(_self, [&](auto& item) {
+        item.referrer = ref_count.first;
+        item.invited = ref_count.second.invited;
+        item.residents = ref_count.second.residents;
+        item.citizens = ref_count.second.citizens;
+      });
+    } else {
+      refcounts.modify(citr, _self, [&](auto& item) {
+        item.invited += ref_count.second.invited;
+        item.residents += ref_count.second.residents;
+        item.citizens += ref_count.second.citizens;
+      });
+    }
+  }
+
+  if (ritr == refs.end()) {
+    size_set(ref_count_cursor, std::numeric_limits<uint64_t>::max());
+  } else {
+    uint64_t next_value = ritr->invited.value;
+    size_set(ref_count_cursor, next_value);
+
+    action next_execution(
+        permission_level{get_self(), "active"_n},
+        get_self(),
+        "initrefcnt"_n,
+        std::make_tuple(next_value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(ref_count_cursor.value, _self);
+  }
+}
+
+void accounts::initcbsbox(uint64_t start, uint64_t chunksize) {
+  require_auth(_self);
+
+  check(chunksize > 0, "chunk size must be > 0");
+
+  rankbox_tables cbs_boxes(get_self(), "cbs"_n.value);
+
+  if (start == 0) {
+    rankbox::clear(cbs_boxes);
+  }
+
+  auto citr = start == 0 ? cbs.begin() : cbs.lower_bound(start);
+  uint64_t count = 0;
+
+  // collect per box first so each box is only written once per chunk
+  std::map<uint64_t, int64_t> box_counts;
+
+  while (citr != cbs.end() && count < chunksize) {
+    box_counts[rankbox::box_for(citr->community_building_score)]++;
     count++;
     citr++;
   }
 
-  if (citr == cbs_by_cbs.end()) {
-    // Done.
+  for (auto & box_count : box_counts) {
+    rankbox::add(cbs_boxes, box_count.first, box_count.second, _self);
+  }
+
+  if (citr == cbs.end()) {
+    size_set(cbs_box_cursor, std::numeric_limits<uint64_t>::max());
   } else {
-    // recursive call
-    uint64_t next_value = citr->by_cbs();
+    uint64_t next_value = citr->account.value;
+    size_set(cbs_box_cursor, next_value);
+
     action next_execution(
         permission_level{get_self(), "active"_n},
         get_self(),
-        "rankcbs"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
+        "initcbsbox"_n,
+        std::make_tuple(next_value, chunksize)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(next_value + 1, _self);
-    
+    tx.send(cbs_box_cursor.value, _self);
+  }
+}
+
+// Not needed once the cbs rank boxes are filled - ranks are read from the boxes, and the rank of an
+// account is updated whenever its score changes. Kept for the scheduler op until it is removed.
+void accounts::rankcbss() {
+  if (get_size(cbs_box_cursor) == std::numeric_limits<uint64_t>::max()) return;
+
+  start_job(rank_cbs_job, 200);
+}
+
+// starts a ranking pass with chunksize - the cursor arguments are left from before jobs and not used.
+// With the cbs rank boxes filled this only brings the rank field of every row up to date.
+void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
+  require_auth(_self);
+  start_job(rank_cbs_job, chunksize);
+}
+
+job::progress accounts::rank_cbs_chunk(uint128_t cursor, uint64_t processed, uint64_t chunksize) {
+  uint64_t total = get_size("cbs.sz"_n);
+  if (total == 0) return job::progress{ 0, 0, true };
+
+  uint64_t current = processed;
+  auto cbs_by_cbs = cbs.get_index<"bycbs"_n>();
+  auto citr = cursor == 0 ? cbs_by_cbs.begin() : cbs_by_cbs.lower_bound(uint64_t(cursor));
+  uint64_t count = 0;
+  std::vector<name> changed;
+
+  while (citr != cbs_by_cbs.end() && count < chunksize) {
+
+    uint64_t rank = cbs_box_ready(citr->account) ? cbs_rank(citr->community_building_score) : utils::rank(current, total);
+
+    if (citr->rank != rank) {
+      cbs_by_cbs.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      changed.push_back(citr->account);
+    }
+
+    current++;
+    count++;
+    citr++;
+  }
+
+  send_queue_cs(changed);
+
+  if (citr == cbs_by_cbs.end()) {
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ citr->by_cbs(), count, false };
 }
 
 void accounts::add_rep_item(name account, uint64_t reputation) {
   check(reputation > 0, "reputation must be > 0");
+  change_rep_box(account, 0, reputation);
   rep.emplace(_self, [&](auto& item) {
     item.account = account;
     item.rep = reputation;
@@ -890,46 +1384,15 @@ void accounts::changesize(name id, int64_t delta) {
 }
 
 void accounts::size_change(name id, int delta) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 void accounts::size_set(name id, uint64_t newsize) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = newsize;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.set(id, newsize);
 }
 
 uint64_t accounts::get_size(name id) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 void accounts::testremove(name user)
@@ -956,8 +1419,15 @@ void accounts::testremove(name user)
     std::make_tuple(user, false)
   ).send();
 
+  change_ref_status(user, uitr->status, not_found);
+
   users.erase(uitr);
   size_change("users.sz"_n, -1);
+
+  auto usitr = userstatus.find(user.value);
+  if (usitr != userstatus.end()) {
+    userstatus.erase(usitr);
+  }
   
 }
 
@@ -975,6 +1445,7 @@ void accounts::testsetrep(name user, uint64_t amount) {
   if (ritr == rep.end()) {
     add_rep_item(user, amount);
   } else {
+    change_rep_box(user, ritr->rep, amount);
     rep.modify(ritr, _self, [&](auto& item) {
       item.rep = amount;
     });
@@ -998,6 +1469,8 @@ void accounts::testsetrs(name user, uint64_t amount) {
       item.rank = amount;
     });
   }
+
+  send_queue_cs({ user });
 }
 
 
@@ -1008,19 +1481,7 @@ void accounts::testsetcbs(name user, uint64_t amount) {
 
   auto usritr = users.find(user.value);
 
-  auto citr = cbs.find(user.value);
-  if (citr == cbs.end()) {
-    cbs.emplace(_self, [&](auto& item) {
-      item.account = user;
-      item.community_building_score = amount;
-      item.rank = 0;
-    });
-    size_change("cbs.sz"_n, 1);
-  } else {
-    cbs.modify(citr, _self, [&](auto& item) {
-      item.community_building_score = amount;
-    });
-  }
+  set_cbs(user, amount);
 
   if (usritr -> type == organization) {
     // register cbs in the cbsorg table to rank orgs
@@ -1035,12 +1496,39 @@ void accounts::testsetcbs(name user, uint64_t amount) {
 
 void accounts::check_user(name account)
 {
-  auto uitr = users.find(account.value);
-  check(uitr != users.end(), "no user");
+  name status, type;
+  check(userstatus::find(userstatus, users, account, status, type), "no user");
+}
+
+void accounts::set_user_status(name account, name status, name type, uint64_t timestamp)
+{
+  auto usitr = userstatus.find(account.value);
+
+  if (usitr == userstatus.end()) {
+    userstatus.emplace(_self, [&](auto & item) {
+      item.account = account;
+      item.status = status;
+      item.type = type;
+      item.timestamp = timestamp;
+    });
+  } else if (usitr->status != status || usitr->type != type) {
+    userstatus.modify(usitr, _self, [&](auto & item) {
+      item.status = status;
+      item.type = type;
+    });
+  }
 }
 
 uint64_t accounts::countrefs(name user, int check_num_residents) 
 {
+    // counters are complete once initrefcnt went through all referrals - until then walk the referrals
+    if (get_size(ref_count_cursor) == std::numeric_limits<uint64_t>::max()) {
+      auto citr = refcounts.find(user.value);
+      uint64_t residents = citr == refcounts.end() ? 0 : citr->residents + citr->citizens;
+      check(int64_t(residents) >= check_num_residents, "user has not referred enough residents or citizens: "+std::to_string(residents));
+      return citr == refcounts.end() ? 0 : citr->invited;
+    }
+
     auto refs_by_referrer = refs.get_index<"byreferrer"_n>();
     if (check_num_residents == 0) {
       return std::distance(refs_by_referrer.lower_bound(user.value), refs_by_referrer.upper_bound(user.value));
@@ -1049,9 +1537,9 @@ uint64_t accounts::countrefs(name user, int check_num_residents)
       int residents = 0;
       auto ritr = refs_by_referrer.lower_bound(user.value);
       while (ritr != refs_by_referrer.end() && ritr->referrer == user) {
-        auto uitr = users.find(ritr->invited.value);
-        if (uitr != users.end()) {
-          if (uitr->status == "resident"_n || uitr->status == "citizen"_n) {
+        name status, type;
+        if (userstatus::find(userstatus, users, ritr->invited, status, type)) {
+          if (status == "resident"_n || status == "citizen"_n) {
             residents++;
           }
         }
@@ -1077,31 +1565,13 @@ uint64_t accounts::rep_score(name user)
     return ritr->rank;
 }
 
-void accounts::send_punish (name account, uint64_t points) {
-  action(
-    permission_level(get_self(), "active"_n),
-    get_self(),
-    "punish"_n,
-    std::make_tuple(account, points)
-  ).send();
-}
-
 void accounts::punish (name account, uint64_t points) {
   require_auth(get_self());
   check_user(account);
-  send_subrep(account, points);
+  add_rep(account, -int64_t(points));
   pnishvouched(account, uint64_t(0));
 }
 
-void accounts::send_punish_vouchers (name account, uint64_t points) {
-  action(
-    permission_level(get_self(), "active"_n),
-    get_self(),
-    "pnshvouchers"_n,
-    std::make_tuple(account, points, uint64_t(0))
-  ).send();
-}
-
 void accounts::pnshvouchers (name account, uint64_t points, uint64_t start) {
   require_auth(get_self());
 
@@ -1114,7 +1584,7 @@ void accounts::pnshvouchers (name account, uint64_t points, uint64_t start) {
   uint64_t lost_points = points * config_float_get("flag.vouch.p"_n);
 
   while (vitr != vouches_by_account_sponsor.end() && vitr->account == account && count < batch_size) {
-    send_subrep(vitr -> sponsor, lost_points);
+    add_rep(vitr -> sponsor, -int64_t(lost_points));
     vitr++;
     count++;
   }
@@ -1131,7 +1601,7 @@ void accounts::pnshvouchers (name account, uint64_t points, uint64_t start) {
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
-    // tx.delay_sec = 1;
+    tx.delay_sec = 1;
     tx.send(next_value, _self);
   }
 }
@@ -1187,9 +1657,7 @@ void accounts::flag (name from, name to) {
     if (to_rep_itr != rep.end()) {
       uint64_t punishment_points = total_flag_points - removed_flag_points;
 
-      send_punish(to, punishment_points);
-      send_eval_demote(to);
-      send_punish_vouchers(to, punishment_points);
+      queue_punishment(to, punishment_points);
       
       if (removed_flag_p_itr == removed_flags.end()) {
         removed_flags.emplace(_self, [&](auto & item){
@@ -1237,95 +1705,197 @@ void accounts::removeflag (name from, name to) {
   flags.erase(flag_itr);
 }
 
-void accounts::send_eval_demote (name to) {
-  
-  uint64_t batch_size = config_get(name("batchsize"));
+// flagged accounts are punished by punishstep, one pass per account. Flags that arrive before the pass
+// took the rep of the account add their points to it, later ones are punished in the next pass.
+void accounts::queue_punishment (name account, uint64_t points) {
+  auto pitr = punishments.find(account.value);
+
+  if (pitr == punishments.end()) {
+    punishments.emplace(_self, [&](auto & item){
+      item.account = account;
+      item.points = points;
+      item.pending = 0;
+      item.stage = punish_start;
+      item.cursor = 0;
+    });
+  } else if (pitr->stage == punish_start) {
+    punishments.modify(pitr, _self, [&](auto & item){
+      item.points += points;
+    });
+  } else {
+    punishments.modify(pitr, _self, [&](auto & item){
+      item.pending += points;
+    });
+  }
+
+  // replaces the step that is already scheduled - a punishment never has more than one
+  send_punish_step(account);
+}
 
+void accounts::send_punish_step (name account) {
   action next_execution(
     permission_level(get_self(), "active"_n),
     get_self(),
-    "evaldemote"_n,
-    std::make_tuple(to, uint64_t(0), uint64_t(0), batch_size)
+    "punishstep"_n,
+    std::make_tuple(account)
   );
 
   transaction tx;
   tx.actions.emplace_back(next_execution);
   tx.delay_sec = 1;
-  tx.send(to.value + 1, _self);
-
+  tx.send((uint128_t(punish_sender) << 64) + account.value, _self, true);
 }
 
-void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
+// one step of the punishment of account: takes its rep, evaluates its status, zeroes the vouches it gave and
+// takes rep from the sponsors that vouched for it - at most batchsize vouches per step
+void accounts::punishstep (name account) {
   require_auth(get_self());
 
-  auto uritr = rep.find(to.value);
-  if (uritr == rep.end()) {
-    updatestatus(to, name("visitor"));
-    return;
-  }
+  auto pitr = punishments.find(account.value);
+  if (pitr == punishments.end()) return;
 
-  uint64_t total = get_size("rep.sz"_n);
-  if (total == 0) return;
-
-  uint64_t current = chunk * chunksize;
-  auto rep_by_rep = rep.get_index<"byrep"_n>();
-  auto ritr = start_val == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(start_val);
+  uint64_t batch_size = config_get("batchsize"_n);
   uint64_t count = 0;
-  bool evaluated = false;
-
-  while (ritr != rep_by_rep.end() && count < chunksize) {
+  name stage = pitr->stage;
+  uint64_t cursor = pitr->cursor;
 
-    if (ritr->account == to) {
-      uint64_t rank = utils::rank(current, total);
+  if (stage == punish_start) {
+    add_rep(account, -int64_t(pitr->points));
+    stage = punish_demote;
+  }
 
-      rep_by_rep.modify(ritr, _self, [&](auto& item) {
-        item.rank = rank;
+  if (stage == punish_demote) {
+    // rep rank boxes are still being filled by initrepbox - the rank would be off, try again later
+    if (get_size(rep_box_cursor) != std::numeric_limits<uint64_t>::max()) {
+      punishments.modify(pitr, _self, [&](auto & item){
+        item.stage = stage;
       });
+      send_punish_step(account);
+      return;
+    }
 
-      auto uitr = users.find(ritr->account.value);
+    eval_demote(account);
+    stage = punish_vouched;
+    cursor = 0;
+  }
 
-      uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
-      uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
+  if (stage == punish_vouched) {
+    auto vouches_by_sponsor_account = vouches.get_index<"byspnsoracct"_n>();
+    auto vitr = vouches_by_sponsor_account.lower_bound((uint128_t(account.value) << 64) + cursor);
 
-      name current_rank = uitr->status;
+    while (vitr != vouches_by_sponsor_account.end() && vitr->sponsor == account && count < batch_size) {
+      if (vitr->vouch_points > 0) {
+        int64_t vouch_points = vitr->vouch_points;
 
-      if (rank < min_rep_score_resident) {
-        current_rank = name("visitor");
-      } else if (rank < min_rep_score_citizen) {
-        current_rank = name("resident");
-      } else {
-        current_rank = name("citizen");
-      }
+        vouches_by_sponsor_account.modify(vitr, _self, [&](auto & item){
+          item.vouch_points = 0;
+        });
 
-      if (uitr->status == name("citizen") && current_rank != name("citizen")) {
-        updatestatus(uitr->account, current_rank);
-      }
-      else if (uitr->status == name("resident") && current_rank == name("visitor")) {
-        updatestatus(uitr->account, name("visitor"));
+        change_vouch_total(vitr->account, -vouch_points);
       }
+      vitr++;
+      count++;
+    }
 
-      evaluated = true;
-      break;
+    if (vitr != vouches_by_sponsor_account.end() && vitr->sponsor == account) {
+      cursor = vitr->account.value;
+    } else {
+      stage = punish_vouchers;
+      cursor = 0;
     }
+  }
 
-    current++;
-    count++;
-    ritr++;
+  bool done = false;
+
+  if (stage == punish_vouchers && count < batch_size) {
+    auto vouches_by_account_sponsor = vouches.get_index<"byacctspnsor"_n>();
+    auto vitr = vouches_by_account_sponsor.lower_bound((uint128_t(account.value) << 64) + cursor);
+    uint64_t lost_points = pitr->points * config_float_get("flag.vouch.p"_n);
+
+    while (vitr != vouches_by_account_sponsor.end() && vitr->account == account && count < batch_size) {
+      add_rep(vitr->sponsor, -int64_t(lost_points));
+      vitr++;
+      count++;
+    }
+
+    if (vitr != vouches_by_account_sponsor.end() && vitr->account == account) {
+      cursor = vitr->sponsor.value;
+    } else {
+      done = true;
+    }
   }
 
-  if (!evaluated && ritr != rep_by_rep.end()) {
-    uint64_t next_value = ritr->by_rep();
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "evaldemote"_n,
-      std::make_tuple(to, next_value, chunk + 1, chunksize)
-    );
+  if (done && pitr->pending == 0) {
+    punishments.erase(pitr);
+    return;
+  }
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value + 1, _self); 
+  punishments.modify(pitr, _self, [&](auto & item){
+    if (done) {
+      item.points = item.pending;
+      item.pending = 0;
+      item.stage = punish_start;
+      item.cursor = 0;
+    } else {
+      item.stage = stage;
+      item.cursor = cursor;
+    }
+  });
+
+  send_punish_step(account);
+}
+
+// start_val, chunk and chunksize are no longer used - the rank comes from the rep rank boxes
+// in one go. Kept so deferred evaldemote calls that are already queued still go through.
+void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
+  require_auth(get_self());
+
+  // boxes are still being filled by initrepbox - the rank would be off
+  check(get_size(rep_box_cursor) == std::numeric_limits<uint64_t>::max(), "rep rank boxes are not initialized, run initrepbox");
+
+  eval_demote(to);
+}
+
+// new status of to from its rep rank
+void accounts::eval_demote (name to) {
+  auto ritr = rep.find(to.value);
+  if (ritr == rep.end()) {
+    updatestatus(to, name("visitor"));
+    return;
+  }
+
+  uint64_t total = get_size("rep.sz"_n);
+  if (total == 0) return;
+
+  uint64_t rank = rep_rank(ritr->rep);
+
+  if (ritr->rank != rank) {
+    rep.modify(ritr, _self, [&](auto& item) {
+      item.rank = rank;
+    });
+    send_queue_cs({ to });
+  }
+
+  auto uitr = users.find(to.value);
+
+  uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
+  uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
+
+  name current_rank = uitr->status;
+
+  if (rank < min_rep_score_resident) {
+    current_rank = name("visitor");
+  } else if (rank < min_rep_score_citizen) {
+    current_rank = name("resident");
+  } else {
+    current_rank = name("citizen");
+  }
+
+  if (uitr->status == name("citizen") && current_rank != name("citizen")) {
+    updatestatus(uitr->account, current_rank);
+  }
+  else if (uitr->status == name("resident") && current_rank == name("visitor")) {
+    updatestatus(uitr->account, name("visitor"));
   }
 
 }
@@ -1348,6 +1918,12 @@ void accounts::testmvouch (name sponsor, name account, uint64_t reps) {
   }
 }
 
+void accounts::auditvouch (name account) {
+  require_auth(get_self());
+
+  calc_vouch_rep(account);
+}
+
 void accounts::migratevouch (name start_user, name start_sponsor) {
   require_auth(get_self());
 
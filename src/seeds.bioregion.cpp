@@ -31,6 +31,8 @@ ACTION bioregion::reset() {
     while(ditr != biodelays.end()) {
         ditr = biodelays.erase(ditr);
     }
+
+    sizes.clear();
 }
 
 void bioregion::auth_founder(name bioregion, name founder) {
@@ -144,6 +146,7 @@ ACTION bioregion::create(
         item.longitude = longitude;
         item.members_count = 0;
     });
+    sizes.change(bioregions_size, 1);
 
     join(bioaccount, founder);
 
@@ -283,6 +286,7 @@ ACTION bioregion::removebr(name bioregion) {
     auto bitr = bioregions.find(bioregion.value);
     check(bitr != bioregions.end(), "The bioregion does not exist.");
     bioregions.erase(bitr);
+    sizes.change(bioregions_size, -1);
 
     roles_tables roles(get_self(), bioregion.value);
     auto ritr = roles.begin();
@@ -298,6 +302,18 @@ ACTION bioregion::removebr(name bioregion) {
     }
 }
 
+ACTION bioregion::initsizes() {
+    require_auth(get_self());
+
+    uint64_t count = 0;
+    auto bitr = bioregions.begin();
+    while (bitr != bioregions.end()) {
+        count++;
+        bitr++;
+    }
+    sizes.set(bioregions_size, count);
+}
+
 void bioregion::create_telos_account(name sponsor, name orgaccount, string publicKey) 
 {
     action(
@@ -324,9 +340,5 @@ void bioregion::size_change(name bioregion, int delta) {
 }
 
 double bioregion::config_float_get(name key) {
-  auto citr = configfloat.find(key.value);
-  if (citr == configfloat.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get_float(key);
 }
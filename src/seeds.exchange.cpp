@@ -98,9 +98,10 @@ void exchange::purchase_usd(name buyer, asset usd_quantity, string paymentSymbol
   check(!is_paused(), "Contract is paused - no purchase possible.");
 
   eosio::multi_index<"users"_n, tables::user_table> users(contracts::accounts, contracts::accounts.value);
+  userstatus_tables statuses(contracts::accounts, contracts::accounts.value);
 
-  auto uitr = users.find(buyer.value);
-  check(uitr != users.end(), "not a seeds user " + buyer.to_string());
+  name status, type;
+  check(userstatus::find(statuses, users, buyer, status, type), "not a seeds user " + buyer.to_string());
 
   configtable c = config.get();
 
@@ -108,7 +109,7 @@ void exchange::purchase_usd(name buyer, asset usd_quantity, string paymentSymbol
   uint64_t seeds_purchased = 0;
 
   asset seeds_limit;
-  switch (uitr->status) {
+  switch (status) {
     case "citizen"_n:
       seeds_limit = c.citizen_limit;
       break;
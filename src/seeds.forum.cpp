@@ -8,46 +8,15 @@
 
 
 void forum::size_change(name id, int delta) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 uint64_t forum::get_size(name id) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 void forum::size_set(name id, uint64_t newsize) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = newsize;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.set(id, newsize);
 }
 
 void forum::createpostcomment(name account, uint64_t post_id, uint64_t backend_id, string url, string body) {
@@ -148,14 +117,18 @@ int64_t forum::pointsfunction(name account, int64_t points_left, uint64_t vbp, u
 int64_t forum::getpoints(name account) {
 
     auto itr = votespower.find(account.value);
-    auto userit = users.get(account.value, "User does not exist.");
-    auto vbpitr = config.get(vbp.value, "Vote Base Point value is not configured.");
-    auto cutoffitr = config.get(cutoff.value, "Cut off value is not configured.");
-    auto cutoffzitr = config.get(cutoffz.value, "Cut off zero value is not configured.");
+    check(users.find(account.value) != users.end(), "User does not exist.");
+
+    // rep table of the accounts contract - users.reputation is no longer updated
+    auto ritr = reps.find(account.value);
+    uint64_t reputation = ritr == reps.end() ? 0 : ritr->rep;
+    uint64_t vbp_value = config_snapshot::get(vbp);
+    uint64_t cutoff_value = config_snapshot::get(cutoff);
+    uint64_t cutoffz_value = config_snapshot::get(cutoffz);
 
     if(itr == votespower.end()){
-        auto maxpitr = config.get(maxpoints.value, "Max points value is not configured.");
-        int64_t max_points = (maxpitr.value) * (vbpitr.value / 10000.0) * (userit.reputation / 10000.0);
+        uint64_t max_points_value = config_snapshot::get(maxpoints);
+        int64_t max_points = (max_points_value) * (vbp_value / 10000.0) * (reputation / 10000.0);
 
         votespower.emplace(_self, [&](auto& new_vote) {
             new_vote.account = account;
@@ -164,10 +137,10 @@ int64_t forum::getpoints(name account) {
             new_vote.max_points = max_points;
         });
 
-        return pointsfunction(account, max_points, vbpitr.value, userit.reputation, cutoffitr.value, cutoffzitr.value);
+        return pointsfunction(account, max_points, vbp_value, reputation, cutoff_value, cutoffz_value);
     }
 
-    return pointsfunction(account, itr -> points_left, vbpitr.value, userit.reputation, cutoffitr.value, cutoffzitr.value);
+    return pointsfunction(account, itr -> points_left, vbp_value, reputation, cutoff_value, cutoffz_value);
 
 }
 
@@ -204,11 +177,11 @@ int forum::updatevote(name account, uint64_t id, uint64_t post_id, uint64_t comm
 
 
 int64_t forum::getdpoints(int64_t points, uint64_t periods){
-    auto ditr = config.get(depreciation.value, "Depreciation factor is not configured.");
+    uint64_t depreciation_value = config_snapshot::get(depreciation);
     uint64_t total_d = 10000;
     int64_t total = 0;
     for(uint64_t i = 0; i < periods; i++){
-        total_d *= ditr.value / 10000.0;
+        total_d *= depreciation_value / 10000.0;
     }
 
     total = points * (total_d / 10000.0);
@@ -219,8 +192,7 @@ int64_t forum::getdpoints(int64_t points, uint64_t periods){
 
 uint64_t forum::getdperiods(uint64_t timestamp) {
     uint64_t t = eosio::current_time_point().sec_since_epoch();
-    auto itr = config.get(depreciations.value, "Depreciations value is not configured.");
-    uint64_t v = (t - timestamp) / itr.value;
+    uint64_t v = (t - timestamp) / config_snapshot::get(depreciations);
     return v;
 }
 
@@ -256,10 +228,9 @@ ACTION forum::reset() {
         aitr = actives.erase(aitr);
     }
 
-    auto sitr = sizes.begin();
-    while (sitr != sizes.end()) {
-        sitr = sizes.erase(sitr);
-    }
+    sizes.clear();
+
+    job::clear(jobs);
 }
 
 
@@ -369,13 +340,12 @@ ACTION forum::downvotecomt(name account, uint64_t post_id, uint64_t comment_id)
 ACTION forum::onperiod() {
     require_auth(permission_level(contracts::forum, "execute"_n));
 
-    auto ditr = config.get(depreciation.value, "Depreciation factor is not configured.");
-    uint64_t depreciation = ditr.value;
+    uint64_t depreciation_value = config_snapshot::get(depreciation);
 
     auto itr = forumreps.begin();
     while(itr != forumreps.end()){
         forumreps.modify(itr, _self, [&](auto& new_frep) {
-            new_frep.reputation *= depreciation / 10000.0;
+            new_frep.reputation *= depreciation_value / 10000.0;
         });
         itr++;
     }
@@ -392,19 +362,57 @@ ACTION forum::newday() {
 }
 
 ACTION forum::rankforums() {
-    uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
-    rankforum(0, batch_size, 0);
+    uint64_t batch_size = config_snapshot::get(name("batchsize"));
+    start_job(rank_forum_job, batch_size);
 }
 
+// starts ranking with chunksize - the cursor arguments are left from before jobs and not used
 ACTION forum::rankforum(uint64_t start, uint64_t chunksize, uint64_t chunk) {
     require_auth(get_self());
+    start_job(rank_forum_job, chunksize);
+}
+
+void forum::start_job(name job, uint64_t chunksize, uint64_t arg, uint128_t cursor) {
+    uint64_t run = job::start(jobs, get_self(), job, chunksize, arg, cursor);
+    if (run > 0) {
+        jobstep(job, run);
+    }
+}
 
+ACTION forum::jobstep(name job, uint64_t run) {
+    require_auth(get_self());
+
+    job::step(jobs, get_self(), job, run, [&](const auto & item) {
+        if (job == rank_forum_job) {
+            return rank_forum_chunk(item.cursor, item.processed, item.chunksize);
+        }
+        if (job == give_rep_job) {
+            return give_rep_chunk(uint64_t(item.cursor), item.chunksize, item.arg);
+        }
+        if (job == delete_active_job) {
+            return delete_active_chunk(item.chunksize);
+        }
+        check(false, "unknown job " + job.to_string());
+        return job::progress{ 0, 0, true };
+    });
+}
+
+// byrep is not unique - the cursor is (reputation key << 64) + account, rows with the same key are
+// in account order so the chunk skips the ones before the account it stopped at
+job::progress forum::rank_forum_chunk(uint128_t cursor, uint64_t current, uint64_t chunksize) {
     uint64_t total = get_size(repsize);
-    if (total == 0) return;
+    if (total == 0) return job::progress{ 0, 0, true };
 
-    uint64_t current = chunk * chunksize;
     auto forum_rep_by_points = forumreps.get_index<"byrep"_n>();
-    auto fitr = start == 0 ? forum_rep_by_points.begin() : forum_rep_by_points.lower_bound(start);
+    auto fitr = forum_rep_by_points.begin();
+    if (cursor != 0) {
+        uint64_t key = uint64_t(cursor >> 64);
+        uint64_t account = uint64_t(cursor);
+        fitr = forum_rep_by_points.lower_bound(key);
+        while (fitr != forum_rep_by_points.end() && fitr->by_reputation() == key && fitr->account.value < account) {
+            fitr++;
+        }
+    }
     uint64_t count = 0;
 
     while (fitr != forum_rep_by_points.end() && count < chunksize) {
@@ -420,20 +428,11 @@ ACTION forum::rankforum(uint64_t start, uint64_t chunksize, uint64_t chunk) {
         fitr++;
     }
 
-    if (fitr != forum_rep_by_points.end()) {
-        uint64_t next_value = (fitr -> account).value;
-        action next_execution(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "rankforum"_n,
-            std::make_tuple(next_value, chunk + 1, chunksize)
-        );
-
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(repsize.value, _self);
+    if (fitr == forum_rep_by_points.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ (uint128_t(fitr->by_reputation()) << 64) + fitr->account.value, count, false };
 }
 
 uint64_t forum::get_available_points() {
@@ -449,59 +448,64 @@ uint64_t forum::get_available_points() {
 }
 
 ACTION forum::givereps() {
-    uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
+    uint64_t batch_size = config_snapshot::get(name("batchsize"));
     uint64_t available_points = get_available_points();
-    giverep(0, batch_size, available_points);
+    start_job(give_rep_job, batch_size, available_points);
     delteactives();
 }
 
+// gives rep from start on - from deferred transactions sent before jobs, givereps starts the job
 ACTION forum::giverep(uint64_t start, uint64_t chunksize, uint64_t available_points) {
     require_auth(get_self());
+    start_job(give_rep_job, chunksize, available_points, start);
+}
 
+job::progress forum::give_rep_chunk(uint64_t start, uint64_t chunksize, uint64_t available_points) {
     // uint64_t max_forum_rep = config.get(name("forum.maxrep").value, "The forum.maxrep parameter has not been initialized yet").value;
     auto fitr = start == 0 ? forumreps.begin() : forumreps.find(start);
     uint64_t count = 0;
     double multiplier = available_points / 4851.0;
+    std::vector<rep_change> rep_changes;
 
     while (fitr != forumreps.end() && count < chunksize) {
         uint64_t rep = std::min(multiplier * fitr -> rank, 10.0);
         print("multiplier = ", multiplier, ", rank = ", fitr -> rank, ", result = ", rep, "\n");
         if (rep > 0) {
-            action(
-                permission_level(contracts::accounts, "active"_n),
-                contracts::accounts,
-                "addrep"_n,
-                std::make_tuple(fitr -> account, rep)
-            ).send();
+            rep_changes.push_back(rep_change{ fitr -> account, int64_t(rep) });
         }
         fitr++;
         count++;
     }
 
-    if (fitr != forumreps.end()) {
-        uint64_t next_value = (fitr -> account).value;
-        action next_execution(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "giverep"_n,
-            std::make_tuple(next_value, chunksize, available_points)
-        );
+    // the whole chunk in one addreps
+    if (!rep_changes.empty()) {
+        action(
+            permission_level(contracts::accounts, "active"_n),
+            contracts::accounts,
+            "addreps"_n,
+            std::make_tuple(rep_changes)
+        ).send();
+    }
 
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(activesize.value, _self);
+    if (fitr == forumreps.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ (fitr -> account).value, count, false };
 }
 
 ACTION forum::delteactives() {
-    uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
-    deleteactive(batch_size);
+    uint64_t batch_size = config_snapshot::get(name("batchsize"));
+    start_job(delete_active_job, batch_size);
 }
 
 ACTION forum::deleteactive(uint64_t chunksize) {
     require_auth(get_self());
+    start_job(delete_active_job, chunksize);
+}
 
+// always starts at the beginning - the rows before were deleted by the last chunk
+job::progress forum::delete_active_chunk(uint64_t chunksize) {
     auto aitr = actives.begin();
     uint64_t count = 0;
 
@@ -511,20 +515,11 @@ ACTION forum::deleteactive(uint64_t chunksize) {
     }
     size_change(activesize, -1 * count);
 
-    if (aitr != actives.end()) {
-        auto next_value = aitr -> account;
-        action next_execution(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "deleteactive"_n,
-            std::make_tuple(chunksize)
-        );
-
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(next_value.value, _self);
+    if (aitr == actives.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ aitr -> account.value, count, false };
 }
 
 ACTION forum::testsize (name id, uint64_t size) {
@@ -9,10 +9,7 @@ ACTION gratitude::reset () {
     bitr = balances.erase(bitr);
   }
 
-  auto sitr = sizes.begin();
-  while (sitr != sizes.end()) {
-    sitr = sizes.erase(sitr);
-  }
+  sizes.clear();
 
   auto stitr = stats.begin();
   while (stitr != stats.end()) {
@@ -54,6 +51,8 @@ ACTION gratitude::newround() {
   uint64_t tot_accounts = get_size("balances.sz"_n);
   uint64_t volume = get_current_volume();
 
+  std::vector<token::payout> payouts;
+
   auto bitr = balances.begin();
   while (bitr != balances.end()) {
     uint64_t my_received = bitr->received.amount;
@@ -64,9 +63,11 @@ ACTION gratitude::newround() {
     float split_factor = my_received / (float)volume;
     uint64_t payout = contract_balance.amount * split_factor;
     // Pay out SEEDS in store
-    if (payout > 0) _transfer(bitr->account, asset(payout, seeds_symbol), "gratitude bonus");
+    if (payout > 0) payouts.push_back(token::payout{ bitr->account, asset(payout, seeds_symbol) });
     bitr++;
   }
+
+  _transfer_many(payouts, "gratitude bonus");
 }
 
 /// ----------================ PRIVATE ================----------
@@ -135,60 +136,25 @@ void gratitude::sub_gratitude (name account, asset quantity) {
 }
 
 void gratitude::size_change(name id, int delta) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 void gratitude::size_set(name id, uint64_t newsize) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = newsize;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.set(id, newsize);
 }
 
 uint64_t gratitude::get_size(name id) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 
 uint64_t gratitude::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get(key);
 }
 
 // Transfers out stored SEEDS
-void gratitude::_transfer (name beneficiary, asset quantity, string memo) {
-  utils::check_asset(quantity);
-  token::transfer_action action{contracts::token, {contracts::gratitude, "active"_n}};
-  action.send(contracts::gratitude, beneficiary, quantity, memo);
+void gratitude::_transfer_many (const std::vector<token::payout> & payouts, string memo) {
+  if (payouts.empty()) return;
+  token::transfermany_action action{contracts::token, {contracts::gratitude, "active"_n}};
+  action.send(contracts::gratitude, payouts, memo);
 }
\ No newline at end of file
@@ -17,6 +17,12 @@ void harvest::reset() {
   while (ritr != refunds.end()) {
     ritr = refunds.erase(ritr);
   }
+
+  refund_schedule_tables schedules(get_self(), user.value);
+  auto sitr = schedules.begin();
+  while (sitr != schedules.end()) {
+    sitr = schedules.erase(sitr);
+  }
   
   auto titr = txpoints.begin();
   while (titr != txpoints.end()) {
@@ -31,16 +37,21 @@ void harvest::reset() {
   }
   size_set(org_tx_points_size, 0);
 
-  auto sitr = sizes.begin();
-  while (sitr != sizes.end()) {
-    sitr = sizes.erase(sitr);
-  }
+  clear_bio_cycle(get_size(bio_cs_cycle));
+  clear_bio_cycle(get_size(bio_cs_ready));
+
+  sizes.clear();
 
   auto pitr = planted.begin();
   while (pitr != planted.end()) {
     pitr = planted.erase(pitr);
   }
 
+  rankbox_tables planted_boxes(get_self(), "planted"_n.value);
+  rankbox::clear(planted_boxes);
+  size_set(planted_box_cursor, std::numeric_limits<uint64_t>::max());
+  size_set(rank_sum_cursor, std::numeric_limits<uint64_t>::max());
+
   auto qitr = monthlyqevs.begin();
   while (qitr != monthlyqevs.end()) {
     qitr = monthlyqevs.erase(qitr);
@@ -62,9 +73,28 @@ void harvest::reset() {
     bcsitr = biocstemp.erase(bcsitr);
   }
 
-  total.remove();
+  // scores are gone - every user is calculated again
+  auto cqitr = csqueue.begin();
+  while (cqitr != csqueue.end()) {
+    cqitr = csqueue.erase(cqitr);
+  }
+  for (auto uitr = users.begin(); uitr != users.end(); uitr++) {
+    queue_cs(uitr->account);
+  }
 
-  init_balance(_self);
+  job::clear(jobs);
+
+  auto hiitr = harvestindex.begin();
+  while (hiitr != harvestindex.end()) {
+    hiitr = harvestindex.erase(hiitr);
+  }
+
+  auto hcitr = harvestclaims.begin();
+  while (hcitr != harvestclaims.end()) {
+    hcitr = harvestclaims.erase(hcitr);
+  }
+
+  total.remove();
 }
 
 void harvest::plant(name from, name to, asset quantity, string memo) {
@@ -88,8 +118,7 @@ void harvest::plant(name from, name to, asset quantity, string memo) {
 
     check_user(target);
 
-    init_balance(target);
-    init_balance(_self);
+    settle_harvest(target);
 
     add_planted(target, quantity);
 
@@ -98,21 +127,24 @@ void harvest::plant(name from, name to, asset quantity, string memo) {
 }
 
 void harvest::add_planted(name account, asset quantity) {
-  auto bitr = balances.find(account.value);
-  balances.modify(bitr, _self, [&](auto& user) {
-    user.planted += quantity;
-  });
   auto pitr = planted.find(account.value);
   if (pitr == planted.end()) {
+    size_change(planted_size, 1);
+    change_planted_box(account, 0, quantity.amount);
+    uint64_t rank = planted_box_ready(account) ? planted_rank(quantity.amount) : 0;
     planted.emplace(_self, [&](auto& item) {
       item.account = account;
       item.planted = quantity;
-      item.rank = 0;
+      item.rank = rank;
     });
-    size_change(planted_size, 1);
+    if (rank > 0) queue_cs(account);
   } else {
+    change_planted_box(account, pitr->planted.amount, pitr->planted.amount + quantity.amount);
+    uint64_t rank = planted_box_ready(account) ? planted_rank(pitr->planted.amount + quantity.amount) : pitr->rank;
+    if (rank != pitr->rank) queue_cs(account);
     planted.modify(pitr, _self, [&](auto& item) {
       item.planted += quantity;
+      item.rank = rank;
     });
   }
   
@@ -121,20 +153,21 @@ void harvest::add_planted(name account, asset quantity) {
 }
 
 void harvest::sub_planted(name account, asset quantity) {
-  auto fromitr = balances.find(account.value);
-  check(fromitr->planted.amount >= quantity.amount, "not enough planted balance");
-  balances.modify(fromitr, _self, [&](auto& user) {
-    user.planted -= quantity;
-  });
-
   auto pitr = planted.find(account.value);
   check(pitr != planted.end(), "user has no balance");
+  check(pitr->planted.amount >= quantity.amount, "not enough planted balance");
   if (pitr->planted.amount == quantity.amount) {
+    change_planted_box(account, pitr->planted.amount, 0);
+    if (pitr->rank > 0) queue_cs(account);
     planted.erase(pitr);
     size_change(planted_size, -1);
   } else {
+    change_planted_box(account, pitr->planted.amount, pitr->planted.amount - quantity.amount);
+    uint64_t rank = planted_box_ready(account) ? planted_rank(pitr->planted.amount - quantity.amount) : pitr->rank;
+    if (rank != pitr->rank) queue_cs(account);
     planted.modify(pitr, _self, [&](auto& item) {
       item.planted -= quantity;
+      item.rank = rank;
     });
   }
   
@@ -142,14 +175,62 @@ void harvest::sub_planted(name account, asset quantity) {
 
 }
 
+bool harvest::planted_box_ready(name account) {
+  return account.value < get_size(planted_box_cursor);
+}
+
+void harvest::change_planted_box(name account, uint64_t old_amount, uint64_t new_amount) {
+  if (!planted_box_ready(account)) return;
+
+  rankbox_tables planted_boxes(get_self(), "planted"_n.value);
+
+  if (old_amount > 0 && new_amount > 0) {
+    rankbox::move(planted_boxes, old_amount, new_amount, _self);
+  } else if (old_amount > 0) {
+    rankbox::add(planted_boxes, rankbox::box_for(old_amount), -1, _self);
+  } else if (new_amount > 0) {
+    rankbox::add(planted_boxes, rankbox::box_for(new_amount), 1, _self);
+  }
+}
+
+// while initplntbox is still filling the boxes the rank is among the accounts counted so far
+uint64_t harvest::planted_rank(uint64_t amount) {
+  rankbox_tables planted_boxes(get_self(), "planted"_n.value);
+
+  bool filled = get_size(planted_box_cursor) == std::numeric_limits<uint64_t>::max();
+  uint64_t total = filled ? get_size(planted_size) : rankbox::count_all(planted_boxes);
+  if (total == 0) return 0;
+
+  return utils::rank(rankbox::count_below(planted_boxes, rankbox::box_for(amount)), total);
+}
+
+// cbs ranks come from the rank boxes of the accounts contract - the rank in the cbs table is only
+// updated when the score of that account changes. Accounts the boxes don't count yet keep their stored
+// rank, the others are ranked among the accounts counted so far until the boxes are filled.
+uint64_t harvest::cbs_rank(name account, uint64_t score, uint64_t stored_rank) {
+  size_tables accts_sizes(contracts::accounts, contracts::accounts.value);
+  auto citr = accts_sizes.find(accts_cbs_box_cursor.value);
+  if (citr == accts_sizes.end() || account.value >= citr->size) return stored_rank;
+
+  rankbox_tables cbs_boxes(contracts::accounts, "cbs"_n.value);
+
+  uint64_t total = 0;
+  if (citr->size == std::numeric_limits<uint64_t>::max()) {
+    auto sitr = accts_sizes.find(accts_cbs_size.value);
+    total = sitr == accts_sizes.end() ? 0 : sitr->size;
+  } else {
+    total = rankbox::count_all(cbs_boxes);
+  }
+  if (total == 0) return 0;
+
+  return utils::rank(rankbox::count_below(cbs_boxes, rankbox::box_for(score)), total);
+}
+
 void harvest::sow(name from, name to, asset quantity) {
     require_auth(from);
     check_user(from);
     check_user(to);
 
-    init_balance(from);
-    init_balance(to);
-
     sub_planted(from, quantity);
     add_planted(to, quantity);
 
@@ -157,65 +238,85 @@ void harvest::sow(name from, name to, asset quantity) {
 
 
 void harvest::claimrefund(name from, uint64_t request_id) {
-  refund_tables refunds(get_self(), from.value);
+  fold_refunds(from);
 
-  auto ritr = refunds.begin();
-  check(ritr != refunds.end(), "No refund found");
+  refund_schedule_tables schedules(get_self(), from.value);
 
-  asset total = asset(0, seeds_symbol);
-  name beneficiary = ritr->account;
+  auto sitr = schedules.find(request_id);
+  check(sitr != schedules.end(), "No refund found");
 
-  while (ritr != refunds.end()) {
-    if (request_id == ritr->request_id) {
-      uint32_t refund_time = ritr->request_time + ONE_WEEK * ritr->weeks_delay;
-      if (refund_time < eosio::current_time_point().sec_since_epoch()) {
-        total += ritr->amount;
-        ritr = refunds.erase(ritr);
-      }
-      else{
-        ritr++;
-      }
-    } else {
-      ritr++;
-    }
+  uint64_t vested = std::min(vested_refund(sitr->total.amount, sitr->request_time), uint64_t(sitr->total.amount - sitr->cancelled.amount));
+  asset payable = asset(0, sitr->total.symbol);
+  if (vested > sitr->claimed.amount) {
+    payable.amount = vested - sitr->claimed.amount;
+  }
+
+  if (payable.amount > 0) {
+    schedules.modify(sitr, _self, [&](auto& schedule) {
+      schedule.claimed += payable;
+    });
+    _withdraw(from, payable);
   }
-  if (total.amount > 0) {
-    _withdraw(beneficiary, total);
+
+  if (sitr->claimed + sitr->cancelled == sitr->total) {
+    schedules.erase(sitr);
   }
+
   action(
       permission_level(contracts::history, "active"_n),
       contracts::history,
       "historyentry"_n,
-      std::make_tuple(from, string("trackrefund"), total.amount, string(""))
+      std::make_tuple(from, string("trackrefund"), payable.amount, string(""))
    ).send();
 }
 
+void harvest::claim(name from) {
+  require_auth(from);
+  check_user(from);
+
+  settle_harvest(from);
+
+  auto citr = harvestclaims.find(from.value);
+  if (citr == harvestclaims.end() || citr->pending.amount == 0) {
+    return;
+  }
+
+  asset quantity = citr->pending;
+  harvestclaims.modify(citr, _self, [&](auto& item) {
+    item.pending.amount = 0;
+  });
+
+  withdraw_aux(get_self(), from, quantity, "harvest");
+}
+
 void harvest::cancelrefund(name from, uint64_t request_id) {
   require_auth(from);
 
-  refund_tables refunds(get_self(), from.value);
+  fold_refunds(from);
 
-  auto ritr = refunds.begin();
+  refund_schedule_tables schedules(get_self(), from.value);
 
   uint64_t totalReplanted = 0;
 
-  while (ritr != refunds.end()) {
-    if (request_id == ritr->request_id) {
-      uint32_t refund_time = ritr->request_time + ONE_WEEK * ritr->weeks_delay;
+  auto sitr = schedules.find(request_id);
+  if (sitr != schedules.end()) {
+    uint64_t vested = vested_refund(sitr->total.amount, sitr->request_time);
+    uint64_t payable = sitr->total.amount - sitr->cancelled.amount;
 
-      if (refund_time > eosio::current_time_point().sec_since_epoch()) {
-        auto bitr = balances.find(from.value);
+    if (payable > vested) {
+      asset replanted = asset(payable - vested, sitr->total.symbol);
 
-        add_planted(from, ritr->amount);
+      add_planted(from, replanted);
 
-        totalReplanted += ritr->amount.amount;
+      totalReplanted = replanted.amount;
 
-        ritr = refunds.erase(ritr);
-      } else {
-        ritr++;
-      }
-    } else {
-      ritr++;
+      schedules.modify(sitr, _self, [&](auto& schedule) {
+        schedule.cancelled += replanted;
+      });
+    }
+
+    if (sitr->claimed + sitr->cancelled == sitr->total) {
+      schedules.erase(sitr);
     }
   }
 
@@ -227,44 +328,99 @@ void harvest::cancelrefund(name from, uint64_t request_id) {
    ).send();
 }
 
-void harvest::unplant(name from, asset quantity) {
-  require_auth(from);
-  check_user(from);
-
-  auto bitr = balances.find(from.value);
-  check(bitr->planted.amount >= quantity.amount, "can't unplant more than planted!");
+// amount of a refund of total that vested by now - a part vests when its week is over
+uint64_t harvest::vested_refund(uint64_t total, uint32_t request_time) {
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  if (now <= request_time) return 0;
 
-  uint64_t lastRequestId = 0;
-  uint64_t lastRefundId = 0;
+  uint64_t weeks = (now - request_time - 1) / ONE_WEEK;
+  if (weeks >= 12) return total;
 
-  refund_tables refunds(get_self(), from.value);
-  if (refunds.begin() != refunds.end()) {
-    auto ritr = refunds.end();
-    ritr--;
-    lastRequestId = ritr->request_id;
-    lastRefundId = ritr->refund_id;
-  }
+  return total / 12 * weeks;
+}
 
-  uint64_t fraction = quantity.amount / 12;
-  uint64_t remainder = quantity.amount % 12;
+// Moves the weekly refund rows of account into one schedule row per request. The rows left of a
+// request are a range of weeks - claimrefund removed the weeks before it, cancelrefund the weeks after.
+void harvest::fold_refunds(name account) {
+  refund_tables refunds(get_self(), account.value);
 
-  for (uint64_t week = 1; week <= 12; week++) {
+  auto ritr = refunds.begin();
+  if (ritr == refunds.end()) return;
 
-    uint64_t amt = fraction;
+  refund_schedule_tables schedules(get_self(), account.value);
 
-    if (week == 12) {
-      amt = amt + remainder;
+  while (ritr != refunds.end()) {
+    uint64_t request_id = ritr->request_id;
+    uint32_t request_time = ritr->request_time;
+    symbol refund_symbol = ritr->amount.symbol;
+
+    uint64_t first_week = 12;
+    int64_t fraction = -1;
+    int64_t last_part = -1;
+    int64_t remaining = 0;
+
+    // refund ids of a request are consecutive
+    while (ritr != refunds.end() && ritr->request_id == request_id) {
+      first_week = std::min(first_week, uint64_t(ritr->weeks_delay));
+      if (ritr->weeks_delay < 12) {
+        fraction = ritr->amount.amount;
+      } else {
+        last_part = ritr->amount.amount;
+      }
+      remaining += ritr->amount.amount;
+      ritr = refunds.erase(ritr);
     }
 
-    refunds.emplace(_self, [&](auto& refund) {
-      refund.request_id = lastRequestId + 1;
-      refund.refund_id = lastRefundId + week;
-      refund.account = from;
-      refund.amount = asset( amt, quantity.symbol );
-      refund.weeks_delay = week;
-      refund.request_time = eosio::current_time_point().sec_since_epoch();
+    // only the last week is left - any fraction with no remainder gives the same schedule
+    if (fraction < 0) fraction = last_part;
+    int64_t remainder = last_part < 0 ? 0 : last_part - fraction;
+
+    int64_t total = fraction * 12 + remainder;
+    int64_t claimed = fraction * (first_week - 1);
+
+    check(schedules.find(request_id) == schedules.end(), "refund request already folded");
+    schedules.emplace(_self, [&](auto& schedule) {
+      schedule.request_id = request_id;
+      schedule.total = asset(total, refund_symbol);
+      schedule.claimed = asset(claimed, refund_symbol);
+      schedule.cancelled = asset(total - claimed - remaining, refund_symbol);
+      schedule.request_time = request_time;
     });
   }
+}
+
+void harvest::migrefunds(name account) {
+  require_auth(get_self());
+  fold_refunds(account);
+}
+
+void harvest::unplant(name from, asset quantity) {
+  require_auth(from);
+  check_user(from);
+
+  settle_harvest(from);
+
+  auto pitr = planted.find(from.value);
+  check(pitr != planted.end() && pitr->planted.amount >= quantity.amount, "can't unplant more than planted!");
+
+  fold_refunds(from);
+
+  refund_schedule_tables schedules(get_self(), from.value);
+
+  uint64_t lastRequestId = 0;
+  if (schedules.begin() != schedules.end()) {
+    auto sitr = schedules.end();
+    sitr--;
+    lastRequestId = sitr->request_id;
+  }
+
+  schedules.emplace(_self, [&](auto& schedule) {
+    schedule.request_id = lastRequestId + 1;
+    schedule.total = quantity;
+    schedule.claimed = asset(0, quantity.symbol);
+    schedule.cancelled = asset(0, quantity.symbol);
+    schedule.request_time = eosio::current_time_point().sec_since_epoch();
+  });
 
   sub_planted(from, quantity);
 
@@ -272,23 +428,16 @@ void harvest::unplant(name from, asset quantity) {
 
 ACTION harvest::updatetxpt(name account) {
   require_auth(get_self());
-  auto uitr = users.get(account.value, "user not found");
-  calc_transaction_points(account, uitr.type);
+  name status, type;
+  check(userstatus::find(userstatus, users, account, status, type), "user not found");
+  calc_transaction_points(account, type);
 }
 
 ACTION harvest::updatecs(name account) {
   require_auth(account);
-  auto uitr = users.get(account.value, "user not found");
-  calc_contribution_score(account, uitr.type);
-}
-
-ACTION harvest::updtotal() { // remove when balances are retired
-  require_auth(get_self());
-
-  auto bitr = balances.find(_self.value);
-  total_table tt = total.get_or_create(get_self(), total_table());
-  tt.total_planted = bitr->planted;
-  total.set(tt, get_self());
+  name status, type;
+  check(userstatus::find(userstatus, users, account, status, type), "user not found");
+  calc_contribution_score(account, type);
 }
 
 ACTION harvest::calctotal(uint64_t startval) {
@@ -376,17 +525,41 @@ uint32_t harvest::calc_transaction_points(name account, name type) {
   uint64_t cutoffdate = now - (utils::moon_cycle * config_float_get("cyctrx.trail"_n));
 
   transaction_points_tables transactions(contracts::history, account.value);
+  trx_points_window_tables windows(contracts::history, contracts::history.value);
 
   uint64_t count = 0;
   uint64_t total_points = 0;
 
-  auto titr = transactions.rbegin();
-  while (titr != transactions.rend() && titr -> timestamp >= cutoffdate) {
+  auto witr = windows.find(account.value);
+  if (witr != windows.end()) {
+    // history keeps the window sum up to date on every transfer - only the days
+    // that left (or entered) the window since the last transfer are visited
+    total_points = witr -> points;
+
+    if (cutoffdate > witr -> window_start) {
+      auto titr = transactions.lower_bound(witr -> window_start);
+      while (titr != transactions.end() && titr -> timestamp < cutoffdate) {
+        total_points -= titr -> points;
+        titr++;
+        count++;
+      }
+    } else if (cutoffdate < witr -> window_start) {
+      auto titr = transactions.lower_bound(cutoffdate);
+      while (titr != transactions.end() && titr -> timestamp < witr -> window_start) {
+        total_points += titr -> points;
+        titr++;
+        count++;
+      }
+    }
+  } else {
+    auto titr = transactions.rbegin();
+    while (titr != transactions.rend() && titr -> timestamp >= cutoffdate) {
 
-    total_points += titr -> points;
+      total_points += titr -> points;
 
-    titr++;
-    count++;
+      titr++;
+      count++;
+    }
   }
 
   if (type == name("organisation")) {
@@ -404,10 +577,13 @@ uint32_t harvest::calc_transaction_points(name account, name type) {
       }
     } else {
       if (total_points > 0) {
-        txpoints.modify(tx_points_itr, _self, [&](auto& entry) {
-          entry.points = total_points; 
-        });
+        if (tx_points_itr->points != total_points) {
+          txpoints.modify(tx_points_itr, _self, [&](auto& entry) {
+            entry.points = total_points; 
+          });
+        }
       } else {
+        if (tx_points_itr->rank > 0) queue_cs(account);
         txpoints.erase(tx_points_itr);
         size_change(tx_points_size, -1);
       }
@@ -418,15 +594,79 @@ uint32_t harvest::calc_transaction_points(name account, name type) {
 }
 
 void harvest::calctrxpts() {
-    calctrxpt(0, 0, 400);
+  start_job(calc_tx_job, 400);
 }
 
+// starts calculating transaction points with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::calctrxpt(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(_self);
+  start_job(calc_tx_job, chunksize);
+}
 
-  check(chunksize > 0, "chunk size must be > 0");
+void harvest::start_job(name job, uint64_t chunksize, uint64_t arg, uint128_t cursor) {
+  uint64_t run = job::start(jobs, get_self(), job, chunksize, arg, cursor);
+  if (run > 0) {
+    jobstep(job, run);
+  }
+}
 
-  uint64_t total = utils::get_users_size();
+void harvest::jobstep(name job, uint64_t run) {
+  require_auth(_self);
+
+  job::step(jobs, get_self(), job, run, [&](const auto & item) {
+    uint64_t cursor = uint64_t(item.cursor);
+
+    if (job == rank_planted_job) {
+      return rank_planted_chunk(item.cursor, item.processed, item.chunksize);
+    }
+    if (job == calc_tx_job) {
+      return calc_tx_chunk(cursor, item.chunksize);
+    }
+    if (job == rank_tx_job) {
+      return rank_tx_chunk(contracts::harvest, cursor, item.processed, item.chunksize);
+    }
+    if (job == rank_org_tx_job) {
+      return rank_tx_chunk("org"_n, cursor, item.processed, item.chunksize);
+    }
+    if (job == calc_cs_job) {
+      return calc_cs_chunk(cursor, item.chunksize);
+    }
+    if (job == rank_cs_job) {
+      return rank_cs_chunk(cursor, item.processed, item.chunksize);
+    }
+    if (job == rank_bio_job) {
+      return score_chunk(item.cursor, item.chunksize, false);
+    }
+    if (job == rank_sums_job) {
+      if (item.chunk == 0) {
+        size_set(sum_rank_users_next, 0);
+        size_set(sum_rank_orgs_next, 0);
+        size_set(rank_sum_cursor, 0);
+        init_bio_rank_sum();
+      }
+      return rank_sums_chunk(cursor, item.chunksize);
+    }
+    if (job == migrate_balances_job) {
+      return migrate_balances_chunk(cursor, item.chunksize);
+    }
+    if (job == score_job) {
+      return score_chunk(item.cursor, item.chunksize, item.arg != 0);
+    }
+    if (job == dist_users_job) {
+      return dist_users_chunk(cursor, item.chunksize, asset(item.arg, test_symbol));
+    }
+    if (job == dist_bios_job) {
+      return dist_bios_chunk(cursor, item.chunksize, asset(item.arg, test_symbol));
+    }
+    if (job == dist_orgs_job) {
+      return dist_orgs_chunk(cursor, item.chunksize, asset(item.arg, test_symbol));
+    }
+    check(false, "unknown job " + job.to_string());
+    return job::progress{ 0, 0, true };
+  });
+}
+
+job::progress harvest::calc_tx_chunk(uint64_t start_val, uint64_t chunksize) {
   auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
   uint64_t count = 0;
 
@@ -437,41 +677,34 @@ void harvest::calctrxpt(uint64_t start_val, uint64_t chunk, uint64_t chunksize)
   }
 
   if (uitr == users.end()) {
-    // done
-  } else {
-    uint64_t next_value = uitr->account.value;
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "calctrxpt"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+    return job::progress{ 0, count, true };
   }
+
+  return job::progress{ uitr->account.value, count, false };
 }
 
 void harvest::rankorgtxs() {
-  ranktx(0, 0, 200, "org"_n);
+  start_job(rank_org_tx_job, 200);
 }
 
 void harvest::ranktxs() {
-  ranktx(0, 0, 200, contracts::harvest);
+  start_job(rank_tx_job, 200);
 }
 
+// starts ranking table with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name table) {
   require_auth(_self);
+  start_job(table == "org"_n ? rank_org_tx_job : rank_tx_job, chunksize);
+}
 
+// ranks one chunk of the tx points table, current is the number of entries ranked before this chunk
+job::progress harvest::rank_tx_chunk(name table, uint64_t start_val, uint64_t current, uint64_t chunksize) {
   auto s = table == "org"_n ? org_tx_points_size : tx_points_size;
   uint64_t total = get_size(s);
-  if (total == 0) return;
+  if (total == 0) return job::progress{ 0, 0, true };
 
   tx_points_tables txpoints_table(get_self(), table.value);
 
-  uint64_t current = chunk * chunksize;
   auto txpt_by_points = txpoints_table.get_index<"bypoints"_n>();
   auto titr = start_val == 0 ? txpt_by_points.begin() : txpt_by_points.lower_bound(start_val);
   uint64_t count = 0;
@@ -480,9 +713,12 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 
     uint64_t rank = utils::rank(current, total);
 
-    txpt_by_points.modify(titr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (titr->rank != rank) {
+      txpt_by_points.modify(titr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      queue_cs(titr->account);
+    }
 
     current++;
     count++;
@@ -490,48 +726,40 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
   }
 
   if (titr == txpt_by_points.end()) {
-    // Done.
-  } else {
-    // recursive call
-    uint64_t next_value = titr->by_points();
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "ranktx"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize, table)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
-    
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ titr->by_points(), count, false };
 }
 
 void harvest::rankplanteds() {
-  rankplanted(0, 0, 200);
+  start_job(rank_planted_job, 200);
 }
 
+// starts ranking planted with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(_self);
+  start_job(rank_planted_job, chunksize);
+}
 
+job::progress harvest::rank_planted_chunk(uint128_t start_val, uint64_t current, uint64_t chunksize) {
   uint64_t total = get_size(planted_size);
-  if (total == 0) return;
+  if (total == 0) return job::progress{ 0, 0, true };
 
-  uint64_t current = chunk * chunksize;
   auto planted_by_planted = planted.get_index<"byplanted"_n>();
   auto pitr = start_val == 0 ? planted_by_planted.begin() : planted_by_planted.lower_bound(start_val);
   uint64_t count = 0;
 
   while (pitr != planted_by_planted.end() && count < chunksize) {
 
-    uint64_t rank = utils::rank(current, total);
+    uint64_t rank = planted_box_ready(pitr->account) ? planted_rank(pitr->planted.amount) : utils::rank(current, total);
 
-    planted_by_planted.modify(pitr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (pitr->rank != rank) {
+      planted_by_planted.modify(pitr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      queue_cs(pitr->account);
+    }
 
     current++;
     count++;
@@ -539,72 +767,129 @@ void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksiz
   }
 
   if (pitr == planted_by_planted.end()) {
-    // Done.
+    return job::progress{ 0, count, true };
+  }
+
+  return job::progress{ pitr->by_planted(), count, false };
+}
+
+void harvest::initplntbox(uint64_t start, uint64_t chunksize) {
+  require_auth(_self);
+
+  check(chunksize > 0, "chunk size must be > 0");
+
+  rankbox_tables planted_boxes(get_self(), "planted"_n.value);
+
+  if (start == 0) {
+    rankbox::clear(planted_boxes);
+  }
+
+  auto pitr = start == 0 ? planted.begin() : planted.lower_bound(start);
+  uint64_t count = 0;
+
+  // collect per box first so each box is only written once per chunk
+  std::map<uint64_t, int64_t> box_counts;
+
+  while (pitr != planted.end() && count < chunksize) {
+    box_counts[rankbox::box_for(pitr->planted.amount)]++;
+    count++;
+    pitr++;
+  }
+
+  for (auto & box_count : box_counts) {
+    rankbox::add(planted_boxes, box_count.first, box_count.second, _self);
+  }
+
+  if (pitr == planted.end()) {
+    size_set(planted_box_cursor, std::numeric_limits<uint64_t>::max());
   } else {
-    // recursive call
-    uint128_t next_value = pitr->by_planted();
+    uint64_t next_value = pitr->account.value;
+    size_set(planted_box_cursor, next_value);
+
     action next_execution(
         permission_level{get_self(), "active"_n},
         get_self(),
-        "rankplanted"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
+        "initplntbox"_n,
+        std::make_tuple(next_value, chunksize)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(pitr->account.value, _self);
-    
+    tx.send(planted_box_cursor.value, _self);
   }
-
 }
 
 void harvest::calccss() {
-  calccs(0, 0, 200);
+  start_job(calc_cs_job, 200);
 }
 
+// starts calculating contribution scores with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::calccs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(_self);
+  start_job(calc_cs_job, chunksize);
+}
 
-  check(chunksize > 0, "chunk size must be > 0");
+// the accounts contract queues the accounts whose rep rank changed in a ranking pass, or whose cbs rank moved with their score
+void harvest::queuecs(std::vector<name> accounts) {
+  require_auth(contracts::accounts);
 
-  uint64_t total = utils::get_users_size();
-  auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
+  for (auto & account : accounts) {
+    queue_cs(account);
+  }
+}
+
+void harvest::queue_cs(name account) {
+  if (csqueue.find(account.value) == csqueue.end()) {
+    csqueue.emplace(_self, [&](auto & item){
+      item.account = account;
+    });
+  }
+}
+
+// Contribution points only change when one of the ranks they are made of changes, so they are only
+// calculated again for the accounts in csqueue - whatever changes a rank queues the account. Accounts
+// queued behind the cursor while a pass runs wait for the next pass. Box ranks moved by other accounts
+// are not queued, see csqueue.
+job::progress harvest::calc_cs_chunk(uint64_t start_val, uint64_t chunksize) {
+  auto qitr = csqueue.lower_bound(start_val);
   uint64_t count = 0;
 
-  while (uitr != users.end() && count < chunksize) {
-    calc_contribution_score(uitr->account, uitr->type);
+  while (qitr != csqueue.end() && count < chunksize) {
+    auto uitr = users.find(qitr->account.value);
+    if (uitr != users.end()) {
+      calc_contribution_score(uitr->account, uitr->type);
+    }
+    qitr = csqueue.erase(qitr);
     count++;
-    uitr++;
   }
 
-  if (uitr == users.end()) {
-    // done
-  } else {
-    uint64_t next_value = uitr->account.value;
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "calccs"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+  if (qitr == csqueue.end()) {
+    return job::progress{ 0, count, true };
   }
+
+  return job::progress{ qitr->account.value, count, false };
 }
 
-// [PS+RT+CB X Rep = Total Contribution Score]
-void harvest::calc_contribution_score(name account, name type) {
+// [PS+RT+CB X Rep = Total Contribution Score] - returns the contribution points
+uint64_t harvest::calc_contribution_score(name account, name type) {
   uint64_t planted_score = 0;
   uint64_t transactions_score = 0;
   uint64_t community_building_score = 0;
   uint64_t reputation_score = 0;
 
   auto pitr = planted.find(account.value);
-  if (pitr != planted.end()) planted_score = pitr->rank;
+  if (pitr != planted.end()) {
+    planted_score = pitr->rank;
+    if (planted_box_ready(account)) {
+      planted_score = planted_rank(pitr->planted.amount);
+      if (planted_score != pitr->rank) {
+        planted.modify(pitr, _self, [&](auto& item) {
+          item.rank = planted_score;
+        });
+      }
+    }
+  }
 
   if (type == "organisation"_n) {
     tx_points_tables orgtxpoints(get_self(), "org"_n.value);
@@ -616,7 +901,7 @@ void harvest::calc_contribution_score(name account, name type) {
   }
 
   auto citr = cbs.find(account.value);
-  if (citr != cbs.end()) community_building_score = citr->rank;
+  if (citr != cbs.end()) community_building_score = cbs_rank(citr->account, citr->community_building_score, citr->rank);
 
   auto ritr = rep.find(account.value);
   if (ritr != rep.end()) reputation_score = ritr->rank;
@@ -634,76 +919,113 @@ void harvest::calc_contribution_score(name account, name type) {
     }
   } else {
     if (contribution_points > 0) {
-      cspoints.modify(csitr, _self, [&](auto& item) {
-        item.contribution_points = contribution_points;
-      });
+      if (csitr->contribution_points != contribution_points) {
+        cspoints.modify(csitr, _self, [&](auto& item) {
+          item.contribution_points = contribution_points;
+        });
+      }
     } else {
+      cs_rank_changed(account, type, csitr->rank, 0);
       cspoints.erase(csitr);
       size_change(cs_size, -1);
     }
   }
 
-  if (type != "organisation"_n) {
-    add_cs_to_bioregion(account, uint32_t(contribution_points));
-  }
+  return contribution_points;
 }
 
-void harvest::add_cs_to_bioregion(name account, uint32_t points) {
+// Bioregion points are summed up per scoring cycle, each cycle in its own scope of biocycle. A users pass
+// starts a cycle, adds the points of every member to its bioregion and makes the cycle the one to rank
+// when it reached the last user - a pass that never finishes is never ranked.
+
+// adds the points of a member to the bioregion of the running cycle - members with 0 points are counted too, the bioregion ranks 0 if all of them have 0
+void harvest::add_cs_to_bioregion(name account, uint64_t points) {
   auto bitr = members.find(account.value);
   if (bitr == members.end()) { return; }
 
-  auto csitr = biocstemp.find(bitr -> bioregion.value);
-  if (csitr == biocstemp.end()) {
-    if (points > 0) {
-      biocstemp.emplace(_self, [&](auto & item){
-        item.bioregion = bitr -> bioregion;
-        item.points = points;
-      });
-      size_change(cs_bio_size, 1);
-    }
-  } else {
-    if (points > 0) {
-      biocstemp.modify(csitr, _self, [&](auto & item){
-        item.points += points;
-      });
-    } else {
-      biocstemp.erase(csitr);
-    }
+  bioregion_cycle_tables biocycle(get_self(), get_size(bio_cs_cycle));
+
+  auto csitr = biocycle.find(bitr -> bioregion.value);
+  if (csitr == biocycle.end()) {
+    biocycle.emplace(_self, [&](auto & item){
+      item.bioregion = bitr -> bioregion;
+      item.points = points;
+    });
+    if (points > 0) size_change(bio_cs_count, 1);
+  } else if (points > 0) {
+    if (csitr -> points == 0) size_change(bio_cs_count, 1);
+    biocycle.modify(csitr, _self, [&](auto & item){
+      item.points += points;
+    });
+  }
+}
+
+void harvest::start_bio_cycle() {
+  uint64_t cycle = get_size(bio_cs_cycle);
+  uint64_t ready = get_size(bio_cs_ready);
+
+  // the last pass didn't finish
+  if (cycle != ready) clear_bio_cycle(cycle);
+
+  size_set(bio_cs_cycle, std::max(cycle, ready) + 1);
+  size_set(bio_cs_count, 0);
+}
+
+void harvest::finish_bio_cycle() {
+  uint64_t cycle = get_size(bio_cs_cycle);
+  uint64_t ready = get_size(bio_cs_ready);
+
+  // whatever is left of the cycle before was not ranked in time
+  if (ready != cycle) clear_bio_cycle(ready);
+
+  size_set(bio_cs_ready, cycle);
+  size_set(cs_bio_size, get_size(bio_cs_count));
+}
+
+void harvest::clear_bio_cycle(uint64_t cycle) {
+  if (cycle == 0) return;
+
+  bioregion_cycle_tables biocycle(get_self(), cycle);
+  auto bitr = biocycle.begin();
+  while (bitr != biocycle.end()) {
+    bitr = biocycle.erase(bitr);
   }
 }
 
 void harvest::rankcss() {
-  size_set(sum_rank_users, 0);
-  size_set(sum_rank_orgs, 0);
-  rankcs(0, 0, 200);
+  // calcscores ranks them too - two walkers on the same ranks hand out wrong ones
+  if (job::active(jobs, score_job)) return;
+  start_job(rank_cs_job, 200);
 }
 
+// starts ranking contribution scores with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(_self);
+  if (job::active(jobs, score_job)) return;
+  start_job(rank_cs_job, chunksize);
+}
 
+// ranks one chunk of cspoints, current is the number of entries ranked before this chunk
+job::progress harvest::rank_cs_chunk(uint64_t start_val, uint64_t current, uint64_t chunksize) {
   uint64_t total = get_size(cs_size);
-  if (total == 0) return;
+  if (total == 0) return job::progress{ 0, 0, true };
 
-  uint64_t current = chunk * chunksize;
   auto cs_by_points = cspoints.get_index<"bycspoints"_n>();
   auto citr = start_val == 0 ? cs_by_points.begin() : cs_by_points.lower_bound(start_val);
   uint64_t count = 0;
-  uint64_t sum_rank_u = 0;
-  uint64_t sum_rank_o = 0;
 
   while (citr != cs_by_points.end() && count < chunksize) {
 
     uint64_t rank = utils::rank(current, total);
 
-    cs_by_points.modify(citr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
-
-    auto uitr = users.find(citr -> account.value);
-    if (uitr -> type != "organisation"_n) {
-      sum_rank_u += rank;
-    } else {
-      sum_rank_o += rank;
+    // only accounts whose rank changes need their type
+    if (citr->rank != rank) {
+      name status, type;
+      userstatus::find(userstatus, users, citr -> account, status, type);
+      cs_rank_changed(citr->account, type, citr->rank, rank);
+      cs_by_points.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
     }
 
     current++;
@@ -711,119 +1033,336 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
     citr++;
   }
 
-  size_change(sum_rank_users, int64_t(sum_rank_u));
-  size_change(sum_rank_orgs, int64_t(sum_rank_o));
-  
-  // print("sum rank users = ", sum_rank, "\n");
-
   if (citr == cs_by_points.end()) {
-    // Done.
-  } else {
-    // recursive call
-    uint64_t next_value = citr->by_cs_points();
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "rankcs"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
-    );
+    return job::progress{ 0, count, true };
+  }
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
-    
+  return job::progress{ citr->by_cs_points(), count, false };
+}
+
+
+// Has to run before the contribution score rank of an account changes - settles the harvest the
+// account collected with its old rank and moves the user or org rank sum by the difference
+void harvest::cs_rank_changed(name account, name type, uint64_t rank, uint64_t new_rank) {
+  settle_harvest(account, type, rank, new_rank);
+
+  uint64_t cursor = get_size(rank_sum_cursor);
+  if (account.value >= cursor) return;
+
+  // while initrnksums runs the sums it rebuilds are moved, the old ones are not used until they are swapped
+  bool rebuilding = cursor != std::numeric_limits<uint64_t>::max();
+  name sum_id = type == "organisation"_n ?
+    (rebuilding ? sum_rank_orgs_next : sum_rank_orgs) :
+    (rebuilding ? sum_rank_users_next : sum_rank_users);
+  size_change(sum_id, int64_t(new_rank) - int64_t(rank));
+}
+
+bool harvest::rank_sums_ready() {
+  return get_size(rank_sum_cursor) == std::numeric_limits<uint64_t>::max();
+}
+
+void harvest::initrnksums(uint64_t chunksize) {
+  require_auth(get_self());
+  start_job(rank_sums_job, chunksize);
+}
+
+// adds the ranks of one chunk of cspoints to the rebuilt user and org rank sums, accounts below the
+// returned cursor are counted - the rebuilt sums replace the ones in use when the last chunk is done
+job::progress harvest::rank_sums_chunk(uint64_t start, uint64_t chunksize) {
+  auto csitr = start == 0 ? cspoints.begin() : cspoints.lower_bound(start);
+  uint64_t count = 0;
+  uint64_t sum_rank_u = 0;
+  uint64_t sum_rank_o = 0;
+
+  while (csitr != cspoints.end() && count < chunksize) {
+    name status, type;
+    userstatus::find(userstatus, users, csitr -> account, status, type);
+    if (type != "organisation"_n) {
+      sum_rank_u += csitr->rank;
+    } else {
+      sum_rank_o += csitr->rank;
+    }
+    csitr++;
+    count++;
+  }
+
+  size_change(sum_rank_users_next, int64_t(sum_rank_u));
+  size_change(sum_rank_orgs_next, int64_t(sum_rank_o));
+
+  if (csitr == cspoints.end()) {
+    size_set(sum_rank_users, get_size(sum_rank_users_next));
+    size_set(sum_rank_orgs, get_size(sum_rank_orgs_next));
+    size_set(sum_rank_users_next, 0);
+    size_set(sum_rank_orgs_next, 0);
+    size_set(rank_sum_cursor, std::numeric_limits<uint64_t>::max());
+    return job::progress{ 0, count, true };
+  }
+
+  size_set(rank_sum_cursor, csitr->account.value);
+  return job::progress{ csitr->account.value, count, false };
+}
+
+void harvest::init_bio_rank_sum() {
+  cs_points_tables biocspoints(get_self(), name("bio").value);
+
+  uint64_t sum_rank_b = 0;
+  for (auto bitr = biocspoints.begin(); bitr != biocspoints.end(); bitr++) {
+    sum_rank_b += bitr->rank;
   }
+  size_set(sum_rank_bios, sum_rank_b);
+}
 
+void harvest::migbalances(uint64_t chunksize) {
+  require_auth(get_self());
+  start_job(migrate_balances_job, chunksize);
 }
 
+// moves one chunk of the legacy balances table into planted and frees its rows. An account that has a
+// planted row keeps it as it is, also when the balances row differs - every plant, unplant and sow wrote
+// planted next to balances, and planted is the one harvest reads.
+job::progress harvest::migrate_balances_chunk(uint64_t start, uint64_t chunksize) {
+  auto bitr = start == 0 ? balances.begin() : balances.lower_bound(start);
+  uint64_t count = 0;
+
+  while (bitr != balances.end() && count < chunksize) {
+    if (bitr->account != get_self()) {
+      auto pitr = planted.find(bitr->account.value);
+      if (pitr == planted.end() && bitr->planted.amount > 0) {
+        add_planted(bitr->account, bitr->planted);
+      }
+    }
+    bitr = balances.erase(bitr);
+    count++;
+  }
+
+  if (bitr == balances.end()) {
+    return job::progress{ 0, count, true };
+  }
+
+  return job::progress{ bitr->account.value, count, false };
+}
 
 void harvest::rankbiocss() {
+  if (job::active(jobs, score_job)) return;
   uint64_t batch_size = config_get("batchsize"_n);
-  size_set(sum_rank_bios, 0);
-  rankbiocs(uint64_t(0), uint64_t(0), batch_size);
+  start_job(rank_bio_job, batch_size, 0, uint128_t(score_stage_prune_bio) << 120);
 }
 
+// starts ranking bioregions with chunksize - the cursor arguments are left from before jobs and not used
 void harvest::rankbiocs(uint64_t start, uint64_t chunk, uint64_t chunksize) {
   require_auth(get_self());
+  if (job::active(jobs, score_job)) return;
+  start_job(rank_bio_job, chunksize, 0, uint128_t(score_stage_prune_bio) << 120);
+}
 
-  uint64_t total = get_size(cs_bio_size);
-  if (total == 0) return;
+// bioregions that are not in the cycle at all - removed, or all members left - lose their rank before
+// the cycle is ranked, or their share would be held back on every harvest. Walks one chunk of biocspoints.
+job::progress harvest::prune_bio_chunk(uint64_t cycle, uint64_t start_val, uint64_t chunksize) {
+  // ranking erases the cycle - a cycle that was ranked already has nothing left to compare with
+  if (cycle == 0 || get_size(bio_cs_ranked) == cycle) return job::progress{ 0, 0, true };
 
   cs_points_tables biocspoints(get_self(), name("bio").value);
+  bioregion_cycle_tables biocycle(get_self(), cycle);
 
-  auto bios_by_points = biocstemp.get_index<"bycspoints"_n>();
-  auto bitr = start == 0 ? bios_by_points.begin() : bios_by_points.find(start);
-  
-  uint64_t current = chunk * chunksize;
+  auto csitr = start_val == 0 ? biocspoints.begin() : biocspoints.lower_bound(start_val);
   uint64_t count = 0;
-  uint64_t sum_rank_b = 0;
+  int64_t sum_rank_delta = 0;
+
+  while (csitr != biocspoints.end() && count < chunksize) {
+    if (biocycle.find(csitr -> account.value) == biocycle.end()) {
+      sum_rank_delta -= int64_t(csitr->rank);
+      csitr = biocspoints.erase(csitr);
+    } else {
+      csitr++;
+    }
+    count++;
+  }
 
-  while (bitr != bios_by_points.end() && count < chunksize) {
+  size_change(sum_rank_bios, sum_rank_delta);
 
-    uint64_t rank = utils::rank(current, total);
+  if (csitr == biocspoints.end()) {
+    return job::progress{ 0, count, true };
+  }
+  return job::progress{ csitr->account.value, count, false };
+}
+
+// ranks one chunk of the bioregion points of a finished cycle, highest points first - current is the number of bioregions
+// ranked before this chunk. Ranked rows are erased, so the cycle is empty when the ranking is done.
+job::progress harvest::rank_bio_chunk(uint64_t cycle, uint64_t current, uint64_t chunksize) {
+  if (cycle == 0) return job::progress{ 0, 0, true };
+
+  uint64_t total = get_size(cs_bio_size);
+
+  cs_points_tables biocspoints(get_self(), name("bio").value);
+  bioregion_cycle_tables biocycle(get_self(), cycle);
+
+  auto bios_by_points = biocycle.get_index<"bycspoints"_n>();
+
+  uint64_t count = 0;
+  int64_t sum_rank_delta = 0;
+
+  while (bios_by_points.begin() != bios_by_points.end() && count < chunksize) {
+    auto bitr = --bios_by_points.end();
 
     auto csitr = biocspoints.find(bitr -> bioregion.value);
-    if (csitr == biocspoints.end()) {
-      biocspoints.emplace(_self, [&](auto & item){
-        item.account = bitr -> bioregion;
-        item.contribution_points = bitr -> points;
-        item.rank = rank;
-      });
-    } else {
-      biocspoints.modify(csitr, _self, [&](auto & item){
-        item.contribution_points = bitr -> points;
-        item.rank = rank;
-      });
-    }
 
-    sum_rank_b += rank;
+    if (bitr -> points > 0 && current < total && bioregions.find(bitr -> bioregion.value) != bioregions.end()) {
+      uint64_t rank = utils::rank(total - 1 - current, total);
+      uint32_t points = uint32_t(std::min(bitr -> points, uint64_t(UINT32_MAX)));
+
+      if (csitr == biocspoints.end()) {
+        biocspoints.emplace(_self, [&](auto & item){
+          item.account = bitr -> bioregion;
+          item.contribution_points = points;
+          item.rank = rank;
+        });
+        sum_rank_delta += int64_t(rank);
+      } else {
+        sum_rank_delta += int64_t(rank) - int64_t(csitr->rank);
+        biocspoints.modify(csitr, _self, [&](auto & item){
+          item.contribution_points = points;
+          item.rank = rank;
+        });
+      }
+    } else if (csitr != biocspoints.end()) {
+      // none of its members has points in this cycle, or it was removed
+      sum_rank_delta -= int64_t(csitr->rank);
+      biocspoints.erase(csitr);
+    }
 
-    bitr = bios_by_points.erase(bitr);
+    bios_by_points.erase(bitr);
     count++;
     current++;
   }
 
-  size_change(sum_rank_bios, int64_t(sum_rank_b));
+  // the sum covers every row in biocspoints, also bioregions that had no members scored in this cycle
+  size_change(sum_rank_bios, sum_rank_delta);
 
-  if (bitr != bios_by_points.end()) {
-    uint64_t next_value = bitr -> by_cs_points();
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "rankbiocs"_n,
-      std::make_tuple(next_value, chunk + 1, chunksize)
-    );
+  if (bios_by_points.begin() != bios_by_points.end()) {
+    return job::progress{ (--bios_by_points.end()) -> bioregion.value, count, false };
+  }
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+  size_set(bio_cs_ranked, cycle);
+  return job::progress{ 0, count, true };
+}
+
+
+void harvest::calcscores() {
+  require_auth(get_self());
+
+  // one scoring run at a time - while a run or a rank cs / rank bio job is moving, this hour is skipped
+  if (job::active(jobs, score_job) || job::active(jobs, rank_cs_job) || job::active(jobs, rank_bio_job)) {
+    return;
+  }
+
+  // a run that stalled goes on with the calc_tx it was started with
+  auto jitr = jobs.find(score_job.value);
+  if (jitr != jobs.end() && jitr->status == job::running) {
+    start_job(score_job, 200);
+    return;
+  }
+
+  // transaction points walk the history tables - keep them on a 24h interval
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  bool calc_tx = now >= get_size(tx_calc_time) + utils::seconds_per_day;
+  if (calc_tx) {
+    size_set(tx_calc_time, now);
+  }
+
+  start_job(score_job, 200, calc_tx ? 1 : 0);
+}
+
+// kept so a calcscore chain that was queued before calcscores ran as a job ends in one
+void harvest::calcscore(uint64_t stage, uint64_t start_val, uint64_t chunk, uint64_t chunksize, bool calc_tx) {
+  calcscores();
+}
+
+// One chunk of the calcscores job, stage by stage:
+// users - with calc_tx: tx points, planted rank, contribution points and bioregion sums of every user, each user read once
+//         without: contribution points of the queued accounts
+// rank tx, rank org tx - only when tx points were recalculated
+// rank cs - contribution score ranks and rank sums for the harvest distribution
+// prune bio, rank bio - bioregion contribution score ranks of the last finished bioregion cycle, also run by rankbiocss
+// Contribution points use the tx ranks from the last time they were ranked.
+// The job cursor holds the stage in the top 8 bits, the rows the stage did so far in the next 56 and
+// the cursor of the stage in the low 64.
+job::progress harvest::score_chunk(uint128_t cursor, uint64_t chunksize, bool calc_tx) {
+  uint64_t stage = uint64_t(cursor >> 120);
+  uint64_t current = uint64_t(cursor >> 64) & ((uint64_t(1) << 56) - 1);
+  uint64_t start_val = uint64_t(cursor);
+
+  job::progress result;
+  if (stage == score_stage_users) {
+    result = score_users_chunk(start_val, chunksize, calc_tx);
+  } else if (stage == score_stage_rank_tx) {
+    result = rank_tx_chunk(contracts::harvest, start_val, current, chunksize);
+  } else if (stage == score_stage_rank_org_tx) {
+    result = rank_tx_chunk("org"_n, start_val, current, chunksize);
+  } else if (stage == score_stage_rank_cs) {
+    result = rank_cs_chunk(start_val, current, chunksize);
+  } else if (stage == score_stage_prune_bio) {
+    result = prune_bio_chunk(get_size(bio_cs_ready), start_val, chunksize);
+  } else if (stage == score_stage_rank_bio) {
+    result = rank_bio_chunk(get_size(bio_cs_ready), current, chunksize);
   } else {
-    size_set(cs_bio_size, 0);
+    check(false, "invalid score stage");
+  }
+
+  if (!result.done && result.cursor != 0) {
+    uint128_t next = (uint128_t(stage) << 120) | (uint128_t(current + result.count) << 64) | uint64_t(result.cursor);
+    return job::progress{ next, result.count, false };
   }
 
+  stage++;
+  if (!calc_tx && (stage == score_stage_rank_tx || stage == score_stage_rank_org_tx)) {
+    stage = score_stage_rank_cs;
+  }
+  if (stage > score_stage_rank_bio) {
+    return job::progress{ 0, result.count, true };
+  }
+  return job::progress{ uint128_t(stage) << 120, result.count, false };
 }
 
+// users stage of calcscores - one chunk of users, or of queued accounts without calc_tx
+// Transaction points decay with time, so on calc_tx all users are visited - that pass also sums up the
+// bioregion points of a new cycle. In between only the queued accounts are calculated again.
+job::progress harvest::score_users_chunk(uint64_t start_val, uint64_t chunksize, bool calc_tx) {
+  if (!calc_tx) {
+    return calc_cs_chunk(start_val, chunksize);
+  }
+
+  if (start_val == 0) start_bio_cycle();
+
+  auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
+  uint64_t count = 0;
+
+  while (uitr != users.end() && count < chunksize) {
+    count += calc_transaction_points(uitr->account, uitr->type);
+    uint64_t points = calc_contribution_score(uitr->account, uitr->type);
+    if (uitr->type != "organisation"_n) {
+      add_cs_to_bioregion(uitr->account, points);
+    }
+    auto qitr = csqueue.find(uitr->account.value);
+    if (qitr != csqueue.end()) {
+      csqueue.erase(qitr);
+    }
+    count++;
+    uitr++;
+  }
+
+  if (uitr == users.end()) {
+    finish_bio_cycle();
+    return job::progress{ 0, count, true };
+  }
+  return job::progress{ uitr->account.value, count, false };
+}
 
 void harvest::payforcpu(name account) {
     require_auth(get_self()); // satisfied by payforcpu permission
     require_auth(account);
 
-    auto uitr = users.find(account.value);
-    check(uitr != users.end(), "Not a Seeds user!");
-}
-
-void harvest::init_balance(name account)
-{
-  auto bitr = balances.find(account.value);
-  if (bitr == balances.end()) {
-    balances.emplace(_self, [&](auto& user) {
-      user.account = account;
-      user.planted = asset(0, seeds_symbol);
-      user.reward = asset(0, seeds_symbol);
-    });
-  }
+    name status, type;
+    check(userstatus::find(userstatus, users, account, status, type), "Not a Seeds user!");
 }
 
 void harvest::check_user(name account)
@@ -831,8 +1370,8 @@ void harvest::check_user(name account)
   if (account == contracts::onboarding) {
     return;
   }
-  auto uitr = users.find(account.value);
-  check(uitr != users.end(), "harvest: no user");
+  name status, type;
+  check(userstatus::find(userstatus, users, account, status, type), "harvest: no user");
 }
 
 void harvest::check_asset(asset quantity)
@@ -862,20 +1401,17 @@ void harvest::_withdraw(name beneficiary, asset quantity)
 
 void harvest::testclaim(name from, uint64_t request_id, uint64_t sec_rewind) {
   require_auth(get_self());
-  refund_tables refunds(get_self(), from.value);
 
-  auto ritr = refunds.begin();
-  check(ritr != refunds.end(), "No refund found");
+  fold_refunds(from);
 
-  while (ritr != refunds.end()) {
-    if (request_id == ritr->request_id) {
-      refunds.modify(ritr, _self, [&](auto& refund) {
-        refund.request_time = eosio::current_time_point().sec_since_epoch() - sec_rewind;
-      });
-    }
-    ritr++;
-  }
-  
+  refund_schedule_tables schedules(get_self(), from.value);
+
+  auto sitr = schedules.find(request_id);
+  check(sitr != schedules.end(), "No refund found");
+
+  schedules.modify(sitr, _self, [&](auto& schedule) {
+    schedule.request_time = eosio::current_time_point().sec_since_epoch() - sec_rewind;
+  });
 }
 
 void harvest::testcspoints(name account, uint64_t contribution_points) {
@@ -895,6 +1431,9 @@ void harvest::testcspoints(name account, uint64_t contribution_points) {
         item.contribution_points = contribution_points;
       });
     } else {
+      name status, type;
+      userstatus::find(userstatus, users, account, status, type);
+      cs_rank_changed(account, type, csitr->rank, 0);
       cspoints.erase(csitr);
       size_change(cs_size, -1);
     }
@@ -903,9 +1442,14 @@ void harvest::testcspoints(name account, uint64_t contribution_points) {
 
 void harvest::testupdatecs(name account, uint64_t contribution_score) {
   require_auth(get_self());
+
+  name status, type;
+  userstatus::find(userstatus, users, account, status, type);
+
   auto csitr = cspoints.find(account.value);
   if (csitr == cspoints.end()) {
     if (contribution_score > 0) {
+      cs_rank_changed(account, type, 0, contribution_score);
       cspoints.emplace(_self, [&](auto& item) {
         item.account = account;
         item.rank = contribution_score;
@@ -913,6 +1457,7 @@ void harvest::testupdatecs(name account, uint64_t contribution_score) {
       size_change(cs_size, 1);
     }
   } else {
+    cs_rank_changed(account, type, csitr->rank, contribution_score);
     if (contribution_score > 0) {
       cspoints.modify(csitr, _self, [&](auto& item) {
         item.rank = contribution_score;
@@ -936,46 +1481,15 @@ void harvest::testupdatecs(name account, uint64_t contribution_score) {
   }
 
 void harvest::size_change(name id, int delta) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 void harvest::size_set(name id, uint64_t newsize) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = newsize;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.set(id, newsize);
 }
 
 uint64_t harvest::get_size(name id) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 void harvest::change_total(bool add, asset quantity) {
@@ -1011,6 +1525,7 @@ ACTION harvest::setorgtxpt(name organization, uint64_t tx_points) {
         item.points = tx_points;
       });
     } else {
+      if (oitr->rank > 0) queue_cs(organization);
       orgtxpoints.erase(oitr);
       size_change(org_tx_points_size, -1);
     }
@@ -1022,17 +1537,21 @@ void harvest::calcmqevs () {
   require_auth(get_self());
   
   uint64_t day = utils::get_beginning_of_day_in_seconds();
-  uint64_t cutoff = day - utils::moon_cycle;
   
   qev_tables qevs(contracts::history, contracts::history.value);
-  check(qevs.begin() != qevs.end(), "The qevs table for " + contracts::history.to_string() + " is empty");
+  size_tables history_sizes(contracts::history, contracts::history.value);
 
-  auto qitr = qevs.rbegin();
   uint64_t total_volume = 0;
 
-  while (qitr != qevs.rend() && qitr -> timestamp >= cutoff) {
-    total_volume += qitr -> qualifying_volume;
-    qitr++;
+  auto ditr = history_sizes.find(qev_sum::day_id.value);
+  if (ditr != history_sizes.end() && ditr -> size > 0) {
+    auto vitr = history_sizes.find(qev_sum::volume_id.value);
+    uint64_t sum_volume = vitr == history_sizes.end() ? 0 : vitr -> size;
+    total_volume = qev_sum::roll(qevs, sum_volume, ditr -> size, day);
+  } else {
+    // history has not summed up a transfer yet
+    check(qevs.begin() != qevs.end(), "The qevs table for " + contracts::history.to_string() + " is empty");
+    total_volume = qev_sum::window(qevs, day);
   }
 
   circulating_supply_table c = circulating.get();
@@ -1112,37 +1631,36 @@ void harvest::calcmintrate () {
 }
 
 uint64_t harvest::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get(key);
 }
 
 double harvest::config_float_get(name key) {
-  auto citr = configfloat.find(key.value);
-  if (citr == configfloat.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get_float(key);
 }
 
-void harvest::send_distribute_harvest (name key, asset amount) {
-
-  cancel_deferred(key.value);
+// A run that is still going pays out the amount it was started with. The new amount waits in the
+// sizes entry named after the job and is added to the next run - a stalled run is resumed.
+void harvest::send_distribute_harvest (name job, asset amount) {
+  auto jitr = jobs.find(job.value);
+  if (jitr != jobs.end() && jitr->status == job::running) {
+    size_set(job, get_size(job) + amount.amount);
+    uint64_t run = job::start(jobs, get_self(), job, config_get("batchsize"_n));
+    if (run > 0) {
+      job::schedule(get_self(), job, run);
+    }
+    return;
+  }
 
-  action next_execution(
-    permission_level{get_self(), "active"_n},
-    get_self(),
-    key,
-    std::make_tuple(uint64_t(0), config_get("batchsize"_n), amount)
-  );
+  uint64_t pending = get_size(job);
+  if (pending > 0) {
+    amount.amount += pending;
+    size_set(job, 0);
+  }
 
-  transaction tx;
-  tx.actions.emplace_back(next_execution);
-  tx.delay_sec = 1;
-  tx.send(key.value, _self);
+  uint64_t run = job::start(jobs, get_self(), job, config_get("batchsize"_n), amount.amount);
 
+  // distributed from a deferred transaction like before - runharvest already mints and pays the global share
+  job::schedule(get_self(), job, run);
 }
 
 void harvest::withdraw_aux (name sender, name beneficiary, asset quantity, string memo) {
@@ -1150,6 +1668,12 @@ void harvest::withdraw_aux (name sender, name beneficiary, asset quantity, strin
   t_action.send(sender, beneficiary, quantity, memo);
 }
 
+void harvest::withdraw_many (name sender, const std::vector<token::payout> & payouts, string memo) {
+  if (payouts.empty()) return;
+  token::transfermany_action t_action{contracts::token, { sender, "active"_n }};
+  t_action.send(sender, payouts, memo);
+}
+
 void harvest::runharvest() {
   require_auth(get_self());
 
@@ -1162,6 +1686,9 @@ void harvest::runharvest() {
 
   if (mitr -> mint_rate <= 0) { return; }
 
+  // the harvest per rank point is only right with complete rank sums
+  check(rank_sums_ready(), "rank sums are not complete, run initrnksums");
+
   asset quantity = asset(mitr -> mint_rate, test_symbol);
   string memo = "harvest";
 
@@ -1180,17 +1707,85 @@ void harvest::runharvest() {
   print("amount for orgs: ", asset(mitr -> mint_rate * orgs_percentage, test_symbol), "\n");
   print("amount for global: ", asset(mitr -> mint_rate * global_percentage, test_symbol), "\n");
 
-  send_distribute_harvest("disthvstusrs"_n, asset(mitr -> mint_rate * users_percentage, test_symbol));
-  send_distribute_harvest("disthvstbios"_n, asset(mitr -> mint_rate * bios_percentage, test_symbol));
-  send_distribute_harvest("disthvstorgs"_n, asset(mitr -> mint_rate * orgs_percentage, test_symbol));
+  // users and orgs claim their share, bioregions are few and still get it sent
+  add_harvest_index(harvest_pool_users, asset(mitr -> mint_rate * users_percentage, test_symbol), get_size(sum_rank_users));
+  send_distribute_harvest(dist_bios_job, asset(mitr -> mint_rate * bios_percentage, test_symbol));
+  add_harvest_index(harvest_pool_orgs, asset(mitr -> mint_rate * orgs_percentage, test_symbol), get_size(sum_rank_orgs));
 
   withdraw_aux(get_self(), bankaccts::globaldho, asset(mitr -> mint_rate * global_percentage, test_symbol), "harvest");
 
 }
 
+// adds amount to the harvest per rank point of pool - the amount stays here until it is claimed
+void harvest::add_harvest_index(name pool, asset amount, uint64_t sum_rank) {
+  if (sum_rank == 0) {
+    print("no ranks in ", pool, ", ", amount, " not distributed\n");
+    return;
+  }
+
+  uint128_t delta = uint128_t(amount.amount) * harvest_index_precision / sum_rank;
+
+  auto iitr = harvestindex.find(pool.value);
+  if (iitr == harvestindex.end()) {
+    harvestindex.emplace(_self, [&](auto& item) {
+      item.pool = pool;
+      item.index = delta;
+    });
+  } else {
+    harvestindex.modify(iitr, _self, [&](auto& item) {
+      item.index += delta;
+    });
+  }
+}
+
+// Adds the harvest account collected with rank since it was last settled to its pending harvest,
+// new_rank is the rank it collects with from now on (see cs_rank_changed). An account without a
+// claim row has collected with its current rank since the first harvest.
+void harvest::settle_harvest(name account, name type, uint64_t rank, uint64_t new_rank) {
+  if (rank == 0 && new_rank == 0) return;
+
+  name pool = type == "organisation"_n ? harvest_pool_orgs : harvest_pool_users;
+
+  auto iitr = harvestindex.find(pool.value);
+  uint128_t index = iitr == harvestindex.end() ? 0 : iitr->index;
+
+  auto citr = harvestclaims.find(account.value);
+  if (citr == harvestclaims.end()) {
+    harvestclaims.emplace(_self, [&](auto& item) {
+      item.account = account;
+      item.index = index;
+      item.pending = asset(uint64_t(rank * index / harvest_index_precision), test_symbol);
+    });
+    return;
+  }
+
+  if (citr->index == index) return;
+
+  // the index only goes down when the account moved to the other pool
+  uint64_t earned = index > citr->index ? uint64_t(rank * (index - citr->index) / harvest_index_precision) : 0;
+  harvestclaims.modify(citr, _self, [&](auto& item) {
+    item.index = index;
+    item.pending.amount += earned;
+  });
+}
+
+void harvest::settle_harvest(name account) {
+  auto csitr = cspoints.find(account.value);
+  uint64_t rank = csitr == cspoints.end() ? 0 : csitr->rank;
+
+  name status, type;
+  userstatus::find(userstatus, users, account, status, type);
+
+  settle_harvest(account, type, rank, rank);
+}
+
+// distributes from start on - from deferred transactions sent before harvest claims
 void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amount) {
   require_auth(get_self());
+  start_job(dist_users_job, chunksize, total_amount.amount, start);
+}
 
+job::progress harvest::dist_users_chunk (uint64_t start, uint64_t chunksize, asset total_amount) {
   auto csitr = start == 0 ? cspoints.begin() : cspoints.find(start);
   uint64_t count = 0;
 
@@ -1198,14 +1793,16 @@ void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amou
   check(sum_rank > 0, "the sum rank for users must be greater than zero");
 
   double fragment_seeds = total_amount.amount / double(sum_rank);
+  std::vector<token::payout> payouts;
   
   while (csitr != cspoints.end() && count < chunksize) {
 
-    auto uitr = users.find(csitr -> account.value);
-    if (uitr != users.end() && uitr -> type != "organisation"_n && csitr -> rank > 0) {
+    name status, type;
+    bool is_user = userstatus::find(userstatus, users, csitr -> account, status, type);
+    if (is_user && type != "organisation"_n && csitr -> rank > 0) {
 
-      print("user:", uitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
-      withdraw_aux(get_self(), csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol), "harvest");
+      print("user:", csitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
+      payouts.push_back(token::payout{ csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol) });
     
     }
 
@@ -1213,62 +1810,88 @@ void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amou
     count++;
   }
 
-  if (csitr != cspoints.end()) {
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "disthvstusrs"_n,
-      std::make_tuple(csitr -> account.value, chunksize, total_amount)
-    );
+  withdraw_many(get_self(), payouts, "harvest");
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(sum_rank_users.value, _self);
+  if (csitr == cspoints.end()) {
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ csitr -> account.value, count, false };
 }
 
+// distributes from start on - from deferred transactions sent before jobs, runharvest starts the jobs
 void harvest::disthvstbios (uint64_t start, uint64_t chunksize, asset total_amount) {
   require_auth(get_self());
+  start_job(dist_bios_job, chunksize, total_amount.amount, start);
+}
 
-  auto bitr = start == 0 ? bioregions.begin() : bioregions.find(start);
-
-  uint64_t number_bioregions = distance(bioregions.begin(), bioregions.end());
+// pays bioregions by their contribution score rank - flat while no bioregion has a rank yet
+job::progress harvest::dist_bios_chunk (uint64_t start, uint64_t chunksize, asset total_amount) {
   uint64_t count = 0;
+  std::vector<token::payout> payouts;
+
+  uint64_t sum_rank = get_size(sum_rank_bios);
+  if (sum_rank == 0) {
+    uint64_t number_bioregions = get_bioregions_size();
+    check(number_bioregions > 0, "number of bioregions must be greater than zero");
+    double fragment_seeds = total_amount.amount / double(number_bioregions);
+
+    auto bitr = bioregions.lower_bound(start);
+    while (bitr != bioregions.end() && count < chunksize) {
+      print("bio:", bitr -> id, ", rank:", 1, ", amount:", asset(fragment_seeds, test_symbol), "\n");
+      payouts.push_back(token::payout{ name(bitr -> id), asset(fragment_seeds, test_symbol) });
+
+      bitr++;
+      count++;
+    }
+
+    withdraw_many(get_self(), payouts, "harvest");
 
-  check(number_bioregions > 0, "number of bioregions must be greater than zero");
-  double fragment_seeds = total_amount.amount / double(number_bioregions);
+    if (bitr == bioregions.end()) {
+      return job::progress{ 0, count, true };
+    }
+    return job::progress{ bitr -> id.value, count, false };
+  }
+
+  double fragment_seeds = total_amount.amount / double(sum_rank);
 
-  while (bitr != bioregions.end() && count < chunksize) {
+  cs_points_tables biocspoints(get_self(), name("bio").value);
+  auto csitr = biocspoints.lower_bound(start);
+
+  while (csitr != biocspoints.end() && count < chunksize) {
 
-    // for the moment, all bioregions have rank 1
-    print("bio:", bitr -> id, ", rank:", 1, ", amount:", asset(fragment_seeds, test_symbol), "\n");
-    withdraw_aux(get_self(), name(bitr -> id), asset(fragment_seeds, test_symbol), "harvest");
+    // the share of a removed bioregion stays here
+    if (csitr -> rank > 0 && bioregions.find(csitr -> account.value) != bioregions.end()) {
+      print("bio:", csitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
+      payouts.push_back(token::payout{ csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol) });
+    }
 
-    bitr++;
+    csitr++;
     count++;
   }
 
-  if (bitr != bioregions.end()) {
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "disthvstbios"_n,
-      std::make_tuple(bitr -> id, chunksize, total_amount)
-    );
+  withdraw_many(get_self(), payouts, "harvest");
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(sum_rank_bios.value, _self);
+  if (csitr == biocspoints.end()) {
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ csitr -> account.value, count, false };
+}
+
+uint64_t harvest::get_bioregions_size() {
+  size_tables biosizes(contracts::bioregion, contracts::bioregion.value);
+  auto sitr = biosizes.find(bioregions_size.value);
+  return sitr == biosizes.end() ? 0 : sitr->size;
 }
 
+// distributes from start on - from deferred transactions sent before harvest claims
 void harvest::disthvstorgs (uint64_t start, uint64_t chunksize, asset total_amount) {
   require_auth(get_self());
+  start_job(dist_orgs_job, chunksize, total_amount.amount, start);
+}
 
+job::progress harvest::dist_orgs_chunk (uint64_t start, uint64_t chunksize, asset total_amount) {
   auto csitr = start == 0 ? cspoints.begin() : cspoints.find(start);
   uint64_t count = 0;
 
@@ -1276,14 +1899,16 @@ void harvest::disthvstorgs (uint64_t start, uint64_t chunksize, asset total_amou
   check(sum_rank > 0, "the sum rank for organizations must be greater than zero");
 
   double fragment_seeds = total_amount.amount / double(sum_rank);
+  std::vector<token::payout> payouts;
   
   while (csitr != cspoints.end() && count < chunksize) {
 
-    auto uitr = users.find(csitr -> account.value);
-    if (uitr != users.end() && uitr -> type == "organisation"_n && csitr -> rank > 0) {
+    name status, type;
+    bool is_user = userstatus::find(userstatus, users, csitr -> account, status, type);
+    if (is_user && type == "organisation"_n && csitr -> rank > 0) {
 
-      print("org:", uitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
-      withdraw_aux(get_self(), csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol), "harvest");
+      print("org:", csitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
+      payouts.push_back(token::payout{ csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol) });
     
     }
 
@@ -1291,17 +1916,11 @@ void harvest::disthvstorgs (uint64_t start, uint64_t chunksize, asset total_amou
     count++;
   }
 
-  if (csitr != cspoints.end()) {
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "disthvstorgs"_n,
-      std::make_tuple(csitr -> account.value, chunksize, total_amount)
-    );
+  withdraw_many(get_self(), payouts, "harvest");
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(sum_rank_orgs.value, _self);
+  if (csitr == cspoints.end()) {
+    return job::progress{ 0, count, true };
   }
+
+  return job::progress{ csitr -> account.value, count, false };
 }
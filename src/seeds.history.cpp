@@ -19,6 +19,12 @@ void history::reset(name account) {
     titr = transactions.erase(titr);
   }
 
+  trx_points_window_tables windows(get_self(), get_self().value);
+  auto witr = windows.find(account.value);
+  if (witr != windows.end()) {
+    windows.erase(witr);
+  }
+
   qev_tables qevs(get_self(), account.value);
   auto qitr = qevs.begin();
   while (qitr != qevs.end()) {
@@ -40,10 +46,9 @@ void history::reset(name account) {
     toitr = totals.erase(toitr);
   }
 
-  auto sitr = sizes.begin();
-  while (sitr != sizes.end()) {
-    sitr = sizes.erase(sitr);
-  }
+  sizes.clear();
+
+  job::clear(jobs);
 }
 
 void history::deldailytrx (uint64_t day) {
@@ -150,10 +155,10 @@ void history::historyentry(name account, string action, uint64_t amount, string
 void history::trxentry(name from, name to, asset quantity) {
   require_auth(get_self());
   
-  auto from_user = users.find(from.value);
-  auto to_user = users.find(to.value);
+  name from_status, from_type, to_status, to_type;
   
-  if (from_user == users.end() || to_user == users.end()) {
+  if (!userstatus::find(userstatus, users, from, from_status, from_type) ||
+      !userstatus::find(userstatus, users, to, to_status, to_type)) {
     return;
   }
 
@@ -163,8 +168,8 @@ void history::trxentry(name from, name to, asset quantity) {
   uint64_t transaction_id = transactions.available_primary_key();
   uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
 
-  bool from_is_organization = from_user -> type == "organisation"_n;
-  bool to_is_organization = to_user -> type == "organisation"_n;
+  bool from_is_organization = from_type == "organisation"_n;
+  bool to_is_organization = to_type == "organisation"_n;
 
   int64_t transactions_cap = int64_t(config_get("qev.trx.cap"_n));
   int64_t max_transaction_points_individuals = int64_t(config_get("i.trx.max"_n));
@@ -226,25 +231,18 @@ void history::trxentry(name from, name to, asset quantity) {
     }
   }
 
-  cancel_deferred(from.value);
-
-  action a(
-    permission_level{contracts::history, "active"_n},
-    get_self(),
-    "savepoints"_n,
-    std::make_tuple(transaction_id, timestamp)
-  );
-
-  transaction tx;
-  tx.actions.emplace_back(a);
-  tx.delay_sec = 1;
-  tx.send(from.value, _self);
+  // points, qevs and tx points are recorded right away - the per-pair scan in save_points is
+  // bounded by htry.trx.max and the tx point update only touches the days that moved out of the window
+  save_points(transaction_id, timestamp);
 }
 
-
+// kept so savepoints transactions that are still queued from before go through
 void history::savepoints(uint64_t id, uint64_t timestamp) {
   require_auth(get_self());
+  save_points(id, timestamp);
+}
 
+void history::save_points(uint64_t id, uint64_t timestamp) {
   auto date = eosio::time_point_sec(timestamp / 86400 * 86400);
   uint64_t day = date.utc_seconds;
 
@@ -256,8 +254,9 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
   name from = titr -> from;
   name to = titr -> to;
 
-  auto uitr_from = users.find(from.value);
-  auto uitr_to = users.find(to.value);
+  name from_status, from_type, to_status, to_type;
+  userstatus::find(userstatus, users, from, from_status, from_type);
+  userstatus::find(userstatus, users, to, to_status, to_type);
 
   uint64_t max_number_transactions = config_get("htry.trx.max"_n);
 
@@ -293,46 +292,33 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
 
   save_from_metrics (from, from_points, qualifying_volume, day);
 
-  if (uitr_to -> type == name("organisation")) {
-    transaction_points_tables trx_points_to(get_self(), to.value);
-    auto trx_itr_to = trx_points_to.find(day);
-
-    if (trx_itr_to != trx_points_to.end()) {
-      trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-        item.points += to_points;
-      });
-    } else {
-      trx_points_to.emplace(_self, [&](auto & item){
-        item.timestamp = day;
-        item.points = to_points;
-      });
-    }
+  if (to_type == name("organisation")) {
+    add_trx_points(to, day, to_points);
   }
 
-  if (uitr_from -> type != name("organisation")) {
+  if (from_type != name("organisation")) {
     send_update_txpoints(from);
   }
 }
 
 void history::save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day) {
-  transaction_points_tables trx_points_from(get_self(), from.value);
   qev_tables qevs(get_self(), from.value);
   qev_tables qevs_total(get_self(), get_self().value);
 
-  auto trx_itr = trx_points_from.find(day);
   auto qev_itr = qevs.find(day);
   auto qev_total_itr = qevs_total.find(day);
 
-  if (trx_itr != trx_points_from.end()) {
-    trx_points_from.modify(trx_itr, _self, [&](auto & item){
-      item.points += from_points;
-    });
-  } else {
-    trx_points_from.emplace(_self, [&](auto & item){
-      item.timestamp = day;
-      item.points = from_points;
-    });
+  add_trx_points(from, day, from_points);
+
+  uint64_t sum_day = get_size(qev_sum::day_id);
+  uint64_t sum_volume = get_size(qev_sum::volume_id);
+  if (sum_day == 0) {
+    sum_volume = qev_sum::window(qevs_total, day);
+  } else if (sum_day != day) {
+    sum_volume = qev_sum::roll(qevs_total, sum_volume, sum_day, day);
   }
+  size_set(qev_sum::day_id, day);
+  size_set(qev_sum::volume_id, sum_volume + qualifying_volume);
 
   if (qev_itr != qevs.end()) {
     qevs.modify(qev_itr, _self, [&](auto & item){
@@ -357,6 +343,78 @@ void history::save_from_metrics (name from, int64_t & from_points, int64_t & qua
   }
 }
 
+void history::add_trx_points (name account, uint64_t day, int64_t points) {
+  transaction_points_tables trx_points(get_self(), account.value);
+
+  auto trx_itr = trx_points.find(day);
+
+  if (trx_itr != trx_points.end()) {
+    trx_points.modify(trx_itr, _self, [&](auto & item){
+      item.points += points;
+    });
+  } else {
+    trx_points.emplace(_self, [&](auto & item){
+      item.timestamp = day;
+      item.points = points;
+    });
+  }
+
+  update_trx_window(account, day, points);
+}
+
+// Keeps trxptwindow.points == sum of the account's trxpoints with timestamp >= window_start,
+// and moves window_start to the current cyctrx.trail cutoff. Only the days that enter or
+// leave the window are visited, so this is O(1) per transfer for active accounts.
+void history::update_trx_window (name account, uint64_t day, int64_t points) {
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  uint64_t cutoff = now - (utils::moon_cycle * config_float_get("cyctrx.trail"_n));
+
+  transaction_points_tables trx_points(get_self(), account.value);
+  trx_points_window_tables windows(get_self(), get_self().value);
+
+  auto witr = windows.find(account.value);
+
+  if (witr == windows.end()) {
+    // first transfer since this was introduced - sum the window once
+    uint64_t total_points = 0;
+    auto titr = trx_points.lower_bound(cutoff);
+    while (titr != trx_points.end()) {
+      total_points += titr -> points;
+      titr++;
+    }
+    windows.emplace(_self, [&](auto & item){
+      item.account = account;
+      item.points = total_points;
+      item.window_start = cutoff;
+    });
+    return;
+  }
+
+  uint64_t total_points = witr -> points;
+  if (day >= witr -> window_start) {
+    total_points += points;
+  }
+
+  if (cutoff > witr -> window_start) {
+    auto titr = trx_points.lower_bound(witr -> window_start);
+    while (titr != trx_points.end() && titr -> timestamp < cutoff) {
+      total_points -= titr -> points;
+      titr++;
+    }
+  } else if (cutoff < witr -> window_start) {
+    auto titr = trx_points.lower_bound(cutoff);
+    while (titr != trx_points.end() && titr -> timestamp < witr -> window_start) {
+      total_points += titr -> points;
+      titr++;
+    }
+  }
+
+  windows.modify(witr, _self, [&](auto & item){
+    item.points = total_points;
+    item.window_start = cutoff;
+  });
+}
+
 // CAUTION: this will iterate on all citizens, residents and orgs
 void history::migrate() {
   require_auth(get_self());
@@ -395,66 +453,24 @@ void history::migrate() {
 }
 
 void history::size_change(name id, int delta) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 void history::size_set(name id, uint64_t newsize) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = newsize;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.set(id, newsize);
 }
 
 uint64_t history::get_size(name id) {
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 void history::send_update_txpoints (name from) {
-  // delayed update
-  cancel_deferred(from.value);
-
-  // delayed update
-  cancel_deferred(from.value);
-
-  action a(
+  action(
       permission_level{contracts::harvest, "active"_n},
       contracts::harvest,
       "updatetxpt"_n,
       std::make_tuple(from)
-  );
-
-  transaction tx;
-  tx.actions.emplace_back(a);
-  tx.delay_sec = 1; 
-  tx.send(from.value, _self);
+  ).send();
 }
 
 void history::numtrx(name account) {
@@ -476,27 +492,11 @@ void history::check_user(name account)
 }
 
 uint64_t history::config_get(name key) {
-  DEFINE_CONFIG_TABLE
-  DEFINE_CONFIG_TABLE_MULTI_INDEX
-  config_tables config(contracts::settings, contracts::settings.value);
-
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get(key);
 }
 
 double history::config_float_get(name key) {
-  DEFINE_CONFIG_FLOAT_TABLE
-  DEFINE_CONFIG_FLOAT_TABLE_MULTI_INDEX
-  config_float_tables config(contracts::settings, contracts::settings.value);
-
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_snapshot::get_float(key);
 }
 
 
@@ -526,6 +526,8 @@ void history::testtotalqev (uint64_t numdays, uint64_t volume) {
     current_day -= utils::seconds_per_day;
   }
 
+  size_set(qev_sum::day_id, day);
+  size_set(qev_sum::volume_id, qev_sum::window(qevs_total, day));
 }
 
 
@@ -535,9 +537,29 @@ void history::migrateusers () {
   migrateuser(0, 0, batch_size);
 }
 
+// migrates from start on - the cursor is the user in the upper and the transaction id in the lower 64 bits
 void history::migrateuser (uint64_t start, uint64_t transaction_id, uint64_t chunksize) {
   require_auth(get_self());
 
+  uint64_t run = job::start(jobs, get_self(), migrate_user_job, chunksize, 0, (uint128_t(start) << 64) + transaction_id);
+  if (run > 0) {
+    jobstep(migrate_user_job, run);
+  }
+}
+
+void history::jobstep (name job, uint64_t run) {
+  require_auth(get_self());
+
+  job::step(jobs, get_self(), job, run, [&](const auto & item) {
+    check(job == migrate_user_job, "unknown job " + job.to_string());
+    return migrate_user_chunk(item.cursor, item.chunksize);
+  });
+}
+
+job::progress history::migrate_user_chunk (uint128_t cursor, uint64_t chunksize) {
+  uint64_t start = uint64_t(cursor >> 64);
+  uint64_t transaction_id = uint64_t(cursor);
+
   auto uitr = start == 0 ? users.begin() : users.find(start);
   uint64_t count = 0;
 
@@ -590,22 +612,12 @@ void history::migrateuser (uint64_t start, uint64_t transaction_id, uint64_t chu
     }
   }
 
-  if (uitr != users.end()) {
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "migrateuser"_n,
-      std::make_tuple(uitr -> account.value, transaction_id, chunksize)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(get_self().value, _self);
-  } else {
+  if (uitr == users.end()) {
     print("\n############################ I have FINISHED ############################\n");
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ (uint128_t(uitr -> account.value) << 64) + transaction_id, count, false };
 }
 
 void history::save_migration_user_transaction (name from, name to, asset quantity, uint64_t timestamp) {
@@ -732,17 +744,6 @@ void history::adjust_transactions (uint64_t id, uint64_t timestamp) {
   save_from_metrics(from, from_points, qualifying_volume, day);
   
   if (uitr_to -> type == name("organisation")) {
-    transaction_points_tables trx_points_to(get_self(), to.value);
-    auto trx_itr_to = trx_points_to.find(day);
-    if (trx_itr_to != trx_points_to.end()) {
-      trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-        item.points += to_points;
-      });
-    } else {
-      trx_points_to.emplace(_self, [&](auto & item){
-        item.timestamp = day;
-        item.points = to_points;
-      });
-    }
+    add_trx_points(to, day, to_points);
   }
 }
\ No newline at end of file
@@ -3,9 +3,7 @@
 
 
 uint64_t organization::get_config(name key) {
-    auto citr = config.find(key.value);
-    check(citr != config.end(), ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-    return citr -> value;
+    return config_snapshot::get(key);
 }
 
 void organization::check_owner(name organization, name owner) {
@@ -42,36 +40,15 @@ uint64_t organization::get_beginning_of_day_in_seconds() {
 }
 
 uint64_t organization::get_size(name id) {
-    auto itr = sizes.find(id.value);
-    if (itr == sizes.end()) {
-        return 0;
-    }
-    return itr -> size;
+    return sizes.get(id);
 }
 
 void organization::increase_size_by_one(name id) {
-    auto itr = sizes.find(id.value);
-    if (itr != sizes.end()) {
-        sizes.modify(itr, _self, [&](auto & s){
-            s.size += 1;
-        });
-    } else {
-        sizes.emplace(_self, [&](auto & s){
-            s.id = id;
-            s.size = 1;
-        });
-    }
+    sizes.change(id, 1);
 }
 
 void organization::decrease_size_by_one(name id) {
-    auto itr = sizes.find(id.value);
-    if (itr != sizes.end()) {
-        sizes.modify(itr, _self, [&](auto & s){
-            if (s.size > 0) {
-                s.size -= 1;
-            }
-        });
-    }
+    sizes.change(id, -1);
 }
 
 void organization::deposit(name from, name to, asset quantity, string memo) {
@@ -152,10 +129,7 @@ ACTION organization::reset() {
         bitr = sponsors.erase(bitr);
     }
 
-    auto sitr = sizes.begin();
-    while (sitr != sizes.end()) {
-        sitr = sizes.erase(sitr);
-    }
+    sizes.clear();
 
     auto avgitr = avgvotes.begin();
     while (avgitr != avgvotes.end()) {
@@ -171,6 +145,8 @@ ACTION organization::reset() {
     while (cbsitr != cbsorgs.end()) {
         cbsitr = cbsorgs.erase(cbsitr);
     }
+
+    job::clear(jobs);
 }
 
 
@@ -181,8 +157,7 @@ ACTION organization::create(name sponsor, name orgaccount, string orgfullname, s
     auto bitr = sponsors.find(sponsor.value);
     check(bitr != sponsors.end(), "The sponsor account does not have a balance entry in this contract.");
 
-    auto feeparam = config.get(min_planted.value, "The org.minplant parameter has not been initialized yet.");
-    asset quantity(feeparam.value, seeds_symbol);
+    asset quantity(get_config(min_planted), seeds_symbol);
 
     check(bitr->balance >= quantity, "The user does not have enough credit to create an organization" + bitr->balance.to_string() + " min: "+quantity.to_string());
 
@@ -396,7 +371,7 @@ void organization::vote(name organization, name account, int64_t regen) {
         });
     }
 
-    int64_t min_regen = (int64_t)config.get(name("org.rgen.min").value, "The org.rgen.min parameter has not been initialized yet").value;
+    int64_t min_regen = (int64_t)get_config(name("org.rgen.min"));
     if (org_regen >= min_regen) {
         auto itr_regen = regenscores.find(organization.value);
         if (itr_regen != regenscores.end()) {
@@ -419,7 +394,7 @@ ACTION organization::addregen(name organization, name account, uint64_t amount)
     require_auth(account);
     check_user(account);
 
-    uint64_t maxAmount = config.get(name("org.maxadd").value, "The parameter org.maxadd has not been initialized yet").value;
+    uint64_t maxAmount = get_config(name("org.maxadd"));
     amount = std::min(amount, maxAmount);
 
     revert_previous_vote(organization, account);
@@ -431,7 +406,7 @@ ACTION organization::subregen(name organization, name account, uint64_t amount)
     require_auth(account);
     check_user(account);
 
-    uint64_t minAmount = config.get(name("org.minsub").value, "The parameter org.minsub has not been initialized yet").value;
+    uint64_t minAmount = get_config(name("org.minsub"));
     amount = std::min(amount, minAmount);
 
     revert_previous_vote(organization, account);
@@ -439,21 +414,57 @@ ACTION organization::subregen(name organization, name account, uint64_t amount)
 }
 
 ACTION organization::rankregens() {
-    auto batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet");
-    rankregen((uint64_t)0, (uint64_t)0, batch_size.value);
+    uint64_t batch_size = get_config(name("batchsize"));
+    start_job(rank_regen_job, batch_size);
 }
 
+// starts ranking with chunksize - the cursor arguments are left from before jobs and not used
 ACTION organization::rankregen(uint64_t start, uint64_t chunk, uint64_t chunksize) {
     require_auth(get_self());
+    start_job(rank_regen_job, chunksize);
+}
 
-    check(chunksize > 0, "chunk size must be > 0");
+void organization::start_job(name job, uint64_t chunksize, uint64_t arg, uint128_t cursor) {
+    uint64_t run = job::start(jobs, get_self(), job, chunksize, arg, cursor);
+    if (run > 0) {
+        jobstep(job, run);
+    }
+}
+
+ACTION organization::jobstep(name job, uint64_t run) {
+    require_auth(get_self());
 
+    job::step(jobs, get_self(), job, run, [&](const auto & item) {
+        if (job == clean_dau_job) {
+            return clean_dau_chunk(item.cursor, item.chunksize, item.arg);
+        }
+        if (job == rank_regen_job) {
+            return rank_regen_chunk(item.cursor, item.processed, item.chunksize);
+        }
+        if (job == rank_cbs_job) {
+            return rank_cbs_chunk(uint64_t(item.cursor), item.processed, item.chunksize);
+        }
+        check(false, "unknown job " + job.to_string());
+        return job::progress{ 0, 0, true };
+    });
+}
+
+// byregenavg is not unique - the cursor is (regen key << 64) + org, rows with the same key are in
+// org order so the chunk skips the ones before the org it stopped at
+job::progress organization::rank_regen_chunk(uint128_t cursor, uint64_t current, uint64_t chunksize) {
     uint64_t total = get_size(regen_score_size);
-    if (total == 0) return;
+    if (total == 0) return job::progress{ 0, 0, true };
 
-    uint64_t current = chunk * chunksize;
     auto regen_score_by_avg_regen = regenscores.get_index<"byregenavg"_n>();
-    auto rsitr = start == 0 ? regen_score_by_avg_regen.begin() : regen_score_by_avg_regen.lower_bound(start);
+    auto rsitr = regen_score_by_avg_regen.begin();
+    if (cursor != 0) {
+        uint64_t key = uint64_t(cursor >> 64);
+        uint64_t org = uint64_t(cursor);
+        rsitr = regen_score_by_avg_regen.lower_bound(key);
+        while (rsitr != regen_score_by_avg_regen.end() && rsitr->by_regen_avg() == key && rsitr->org_name.value < org) {
+            rsitr++;
+        }
+    }
     uint64_t count = 0;
 
     while (rsitr != regen_score_by_avg_regen.end() && count < chunksize) {
@@ -469,18 +480,11 @@ ACTION organization::rankregen(uint64_t start, uint64_t chunk, uint64_t chunksiz
         rsitr++;
     }
 
-    if (rsitr != regen_score_by_avg_regen.end()) {
-        action next_execution(
-            permission_level("active"_n, get_self()),
-            get_self(),
-            "rankregen"_n,
-            std::make_tuple((rsitr -> org_name).value, chunk + 1, chunksize)
-        );
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(regen_score_size.value, _self);
+    if (rsitr == regen_score_by_avg_regen.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ (uint128_t(rsitr->by_regen_avg()) << 64) + rsitr->org_name.value, count, false };
 }
 
 ACTION organization::addcbpoints(name organization, uint32_t cbscore) {
@@ -515,20 +519,20 @@ ACTION organization::subcbpoints(name organization, uint32_t cbscore) {
 }
 
 ACTION organization::rankcbsorgs() {
-    auto batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet");
-    rankcbsorg((uint64_t)0, (uint64_t)0, batch_size.value);
+    uint64_t batch_size = get_config(name("batchsize"));
+    start_job(rank_cbs_job, batch_size);
 }
 
+// starts ranking with chunksize - the cursor arguments are left from before jobs and not used
 ACTION organization::rankcbsorg(uint64_t start, uint64_t chunk, uint64_t chunksize) {
     require_auth(get_self());
+    start_job(rank_cbs_job, chunksize);
+}
 
-    check(chunksize > 0, "chunk size must be > 0");
-    
+job::progress organization::rank_cbs_chunk(uint64_t start, uint64_t current, uint64_t chunksize) {
     uint64_t total = get_size(cb_score_size);
+    if (total == 0) return job::progress{ 0, 0, true };
 
-    if (total == 0) return;
-
-    uint64_t current = chunk * chunksize;
     auto cbs_by_points = cbsorgs.get_index<"bycbs"_n>();
     auto cbsitr = start == 0 ? cbs_by_points.begin() : cbs_by_points.lower_bound(start);
     uint64_t count = 0;
@@ -546,19 +550,11 @@ ACTION organization::rankcbsorg(uint64_t start, uint64_t chunk, uint64_t chunksi
         cbsitr++;
     }
 
-    if (cbsitr != cbs_by_points.end()) {
-        uint64_t next_value = (cbsitr -> org_name).value;
-        action next_execution(
-            permission_level("active"_n, get_self()),
-            get_self(),
-            "rankcbsorg"_n,
-            std::make_tuple(next_value, chunk + 1, chunksize)
-        );
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(cb_score_size.value, _self);
+    if (cbsitr == cbs_by_points.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ cbsitr -> by_cbs(), count, false };
 }
 
 uint64_t organization::get_regen_score(name organization) {
@@ -607,7 +603,8 @@ void organization::check_can_make_reputable(name organization) {
     check(oitr != organizations.end(), "the organization does not exist");
     check(oitr->status == regular_org, "the organization is not a regular organization");
 
-    auto bitr = balances.find(organization.value);
+    auto pitr = planted.find(organization.value);
+    uint64_t planted_amount = pitr == planted.end() ? 0 : pitr->planted.amount;
 
     uint64_t planted_min = get_config(name("rep.minplnt"));
     uint64_t regen_min_rank = get_config(name("rep.minrank"));
@@ -619,7 +616,7 @@ void organization::check_can_make_reputable(name organization) {
     uint64_t regen_score = get_regen_score(organization);
     uint64_t valid_trxs = count_transactions(organization);
 
-    check(bitr -> planted.amount >= planted_min, "organization has less than the required amount of seeds planted");
+    check(planted_amount >= planted_min, "organization has less than the required amount of seeds planted");
     check(regen_score >= regen_min_rank, "organization has less than the required regenerative score");
     check(invited_users_number >= min_invited, "organization has less than required referrals. required: " + 
         std::to_string(min_invited) + " actual: " + std::to_string(invited_users_number));
@@ -632,7 +629,8 @@ void organization::check_can_make_regen(name organization) {
     check(oitr != organizations.end(), "the organization does not exist");
     check(oitr->status == reputable_org, "the organization is not reputable");
 
-    auto bitr = balances.find(organization.value);
+    auto pitr = planted.find(organization.value);
+    uint64_t planted_amount = pitr == planted.end() ? 0 : pitr->planted.amount;
 
     uint64_t planted_min = get_config(name("rgen.minplnt"));
     uint64_t regen_min_rank = get_config(name("rgen.minrank"));
@@ -644,7 +642,7 @@ void organization::check_can_make_regen(name organization) {
     uint64_t regen_score = get_regen_score(organization);
     uint64_t valid_trxs = count_transactions(organization);
 
-    check(bitr -> planted.amount >= planted_min, "organization has less than the required amount of seeds planted");
+    check(planted_amount >= planted_min, "organization has less than the required amount of seeds planted");
     check(regen_score >= regen_min_rank, "organization has less than the required regenerative score");
     check(invited_users_number >= min_invited, "organization has less than required referrals. required: " + 
         std::to_string(min_invited) + " actual: " + std::to_string(invited_users_number));
@@ -783,73 +781,72 @@ ACTION organization::cleandaus () {
     require_auth(get_self());
 
     uint64_t today_timestamp = get_beginning_of_day_in_seconds();
+    uint64_t batch_size = get_config(name("batchsize"));
 
-    auto appitr = apps.begin();
-    while (appitr != apps.end()) {
-        if (appitr -> is_banned) {
-            appitr++;
-            continue; 
-        }
-        action clean_dau_action(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "cleandau"_n,
-            std::make_tuple(appitr -> app_name, today_timestamp, (uint64_t)0)
-        );
-
-        transaction tx;
-        tx.actions.emplace_back(clean_dau_action);
-        tx.delay_sec = 1;
-        tx.send((appitr -> app_name).value + 1, _self);
-
-        appitr++;
-    }
+    start_job(clean_dau_job, batch_size, today_timestamp);
 }
 
+// cleans the daus from appname on
 ACTION organization::cleandau (name appname, uint64_t todaytimestamp, uint64_t start) {
     require_auth(get_self());
 
     auto appitr = apps.get(appname.value, "This application does not exist.");
     if (appitr.is_banned) { return; }
 
-    auto batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet.").value;
+    uint64_t batch_size = get_config(name("batchsize"));
 
-    dau_tables daus(get_self(), appname.value);
-    dau_history_tables dau_history(get_self(), appname.value); 
+    start_job(clean_dau_job, batch_size, todaytimestamp, (uint128_t(appname.value) << 64) + start);
+}
 
-    auto dauitr = start == 0 ? daus.begin() : daus.lower_bound(start);
+// one chunk over all apps - the cursor is the app name in the upper and the dau account in the lower 64 bits
+job::progress organization::clean_dau_chunk (uint128_t cursor, uint64_t chunksize, uint64_t todaytimestamp) {
+    uint64_t start = uint64_t(cursor);
+
+    auto appitr = cursor == 0 ? apps.begin() : apps.lower_bound(uint64_t(cursor >> 64));
     uint64_t count = 0;
 
-    while (dauitr != daus.end() && count < batch_size) {
-        if (dauitr -> date != todaytimestamp) {
-            dau_history.emplace(_self, [&](auto & dau_h){
-                dau_h.dau_history_id = dau_history.available_primary_key();
-                dau_h.account = dauitr -> account;
-                dau_h.date = dauitr -> date;
-                dau_h.number_app_uses = dauitr -> number_app_uses;
-            });
-            daus.modify(dauitr, _self, [&](auto & dau){
-                dau.date = todaytimestamp;
-                dau.number_app_uses = 0;
-            });
+    while (appitr != apps.end() && count < chunksize) {
+        if (appitr -> is_banned) {
+            start = 0;
+            appitr++;
+            continue;
         }
-        count++;
-        dauitr++;
+
+        dau_tables daus(get_self(), appitr -> app_name.value);
+        dau_history_tables dau_history(get_self(), appitr -> app_name.value);
+
+        auto dauitr = start == 0 ? daus.begin() : daus.lower_bound(start);
+
+        while (dauitr != daus.end() && count < chunksize) {
+            if (dauitr -> date != todaytimestamp) {
+                dau_history.emplace(_self, [&](auto & dau_h){
+                    dau_h.dau_history_id = dau_history.available_primary_key();
+                    dau_h.account = dauitr -> account;
+                    dau_h.date = dauitr -> date;
+                    dau_h.number_app_uses = dauitr -> number_app_uses;
+                });
+                daus.modify(dauitr, _self, [&](auto & dau){
+                    dau.date = todaytimestamp;
+                    dau.number_app_uses = 0;
+                });
+            }
+            count++;
+            dauitr++;
+        }
+
+        if (dauitr != daus.end()) {
+            return job::progress{ (uint128_t(appitr -> app_name.value) << 64) + dauitr -> account.value, count, false };
+        }
+
+        start = 0;
+        appitr++;
     }
 
-    if (dauitr != daus.end()) {
-        action clean_dau_action(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "cleandau"_n,
-            std::make_tuple(appname, todaytimestamp, (dauitr -> account).value)
-        );
-
-        transaction tx;
-        tx.actions.emplace_back(clean_dau_action);
-        tx.delay_sec = 1;
-        tx.send((appitr.app_name).value + 1, _self);
+    if (appitr == apps.end()) {
+        return job::progress{ 0, count, true };
     }
+
+    return job::progress{ uint128_t(appitr -> app_name.value) << 64, count, false };
 }
 
 ACTION organization::scoretrxs() {
@@ -43,11 +43,9 @@ void proposals::reset() {
     aitr = actives.erase(aitr);
   }
 
-  size_tables sizes(get_self(), get_self().value);
-  auto sitr = sizes.begin();
-  while (sitr != sizes.end()) {
-    sitr = sizes.erase(sitr);
-  }
+  sizes.clear();
+
+  job::clear(jobs);
 
   name scopes[] = { get_self(), alliance_type };
   for (int i = 0; i < 2; i++) {
@@ -177,14 +175,7 @@ asset proposals::get_payout_amount(
 }
 
 uint64_t proposals::get_size(name id) {
-  size_tables sizes(get_self(), get_self().value);
-
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    return 0;
-  } else {
-    return sitr->size;
-  }
+  return sizes.get(id);
 }
 
 void proposals::initsz() {
@@ -208,11 +199,7 @@ void proposals::calcvotepow() {
   require_auth(_self);
   
   // remove unused size
-  size_tables sizes(get_self(), get_self().value);
-  auto sitr = sizes.find("active.sz"_n.value);
-  if (sitr != sizes.end()) {
-    sizes.erase(sitr);
-  }
+  sizes.erase("active.sz"_n);
   DEFINE_CS_POINTS_TABLE
   DEFINE_CS_POINTS_TABLE_MULTI_INDEX
 
@@ -280,6 +267,12 @@ void proposals::onperiod() {
     std::vector<uint64_t> active_props;
     std::vector<uint64_t> eval_props;
 
+    // payouts of passed proposals by fund, each fund pays them in one transfer
+    std::map<name, std::vector<token::payout>> fund_payouts;
+
+    // rep rewards of the creators of passed proposals, sent in one addreps
+    std::vector<rep_change> rep_changes;
+
     // TODO this is not working at the moment, use old way... FIX after this cycle.
 
     // find smallesd prop id that's in open or eval stage
@@ -329,14 +322,17 @@ void proposals::onperiod() {
           if (pitr -> status == status_open) {
 
             refund_staked(pitr->creator, pitr->staked);
-            change_rep(pitr->creator, true);
+            rep_changes.push_back(rep_change{ pitr->creator, int64_t(config_get(name("proppass.rep"))) });
 
             asset payout_amount = get_payout_amount(pitr->pay_percentages, 0, pitr->quantity, pitr->current_payout);
             
             if (is_alliance_type) {
               send_to_escrow(pitr->fund, pitr->recipient, payout_amount, "proposal id: "+std::to_string(pitr->id));
             } else {
-              withdraw(pitr->recipient, payout_amount, pitr->fund, "");// TODO limit by amount available
+              if (payout_amount.amount > 0) { // TODO limit by amount available
+                utils::check_asset(payout_amount);
+                fund_payouts[pitr->fund].push_back(token::payout{ pitr->recipient, payout_amount });
+              }
             }
 
             // TODO: if we allow num_cycles == 1, this needs to go into passed instead of evaluate.
@@ -361,7 +357,10 @@ void proposals::onperiod() {
             if (is_alliance_type) {
               send_to_escrow(pitr->fund, pitr->recipient, payout_amount, "proposal id: "+std::to_string(pitr->id));
             } else {
-              withdraw(pitr->recipient, payout_amount, pitr->fund, "");// TODO limit by amount available
+              if (payout_amount.amount > 0) { // TODO limit by amount available
+                utils::check_asset(payout_amount);
+                fund_payouts[pitr->fund].push_back(token::payout{ pitr->recipient, payout_amount });
+              }
             }
 
             uint64_t num_cycles = pitr -> pay_percentages.size() - 1;
@@ -411,6 +410,12 @@ void proposals::onperiod() {
       pitr++;
     } 
 
+    for (const auto & fund : fund_payouts) {
+      withdraw_many(fund.first, fund.second, "");
+    }
+
+    send_addreps(rep_changes);
+
     update_cycle();
     update_cycle_stats(active_props, eval_props);
     updatevoices();
@@ -507,12 +512,40 @@ void proposals::testperiod() {
 }
 void proposals::updatevoices() {
   require_auth(get_self());
-  updatevoice((uint64_t)0);
+  uint64_t batch_size = config_get(name("batchsize"));
+  start_job(update_voice_job, batch_size);
 }
 
+// updates voices from start on - from deferred transactions sent before jobs, updatevoices starts the job
 void proposals::updatevoice(uint64_t start) {
   require_auth(get_self());
-  
+  uint64_t batch_size = config_get(name("batchsize"));
+  start_job(update_voice_job, batch_size, 0, start);
+}
+
+void proposals::start_job(name job, uint64_t chunksize, uint64_t arg, uint128_t cursor) {
+  uint64_t run = job::start(jobs, get_self(), job, chunksize, arg, cursor);
+  if (run > 0) {
+    jobstep(job, run);
+  }
+}
+
+void proposals::jobstep(name job, uint64_t run) {
+  require_auth(get_self());
+
+  job::step(jobs, get_self(), job, run, [&](const auto & item) {
+    if (job == update_voice_job) {
+      return update_voice_chunk(uint64_t(item.cursor), item.chunksize);
+    }
+    if (job == decay_voice_job) {
+      return decay_voice_chunk(uint64_t(item.cursor), item.chunksize);
+    }
+    check(false, "unknown job " + job.to_string());
+    return job::progress{ 0, 0, true };
+  });
+}
+
+job::progress proposals::update_voice_chunk(uint64_t start, uint64_t chunksize) {
   DEFINE_CS_POINTS_TABLE
   DEFINE_CS_POINTS_TABLE_MULTI_INDEX
   
@@ -528,12 +561,11 @@ void proposals::updatevoice(uint64_t start) {
       size_set(user_active_size, 0);
   }
 
-  uint64_t batch_size = config_get(name("batchsize"));
   uint64_t count = 0;
   uint64_t vote_power = 0;
   uint64_t active_users = 0;
   
-  while (vitr != voice.end() && count < batch_size) {
+  while (vitr != voice.end() && count < chunksize) {
       auto csitr = cspoints.find(vitr->account.value);
       uint64_t points = 0;
       if (csitr != cspoints.end()) {
@@ -554,20 +586,11 @@ void proposals::updatevoice(uint64_t start) {
   size_change(cycle_vote_power_size, vote_power);
   size_change(user_active_size, active_users);
 
-  if (vitr != voice.end()) {
-    uint64_t next_value = vitr->account.value;
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "updatevoice"_n,
-        std::make_tuple(next_value)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+  if (vitr == voice.end()) {
+    return job::progress{ 0, count, true };
   }
+
+  return job::progress{ vitr->account.value, count, false };
 }
 
 uint64_t proposals::get_cycle_period_sec() {
@@ -596,13 +619,17 @@ void proposals::decayvoices() {
     c.t_voicedecay = now;
     cycle.set(c, get_self());
     uint64_t batch_size = config_get(name("batchsize"));
-    decayvoice(0, batch_size);
+    start_job(decay_voice_job, batch_size);
   }
 }
 
+// decays voices from start on - from deferred transactions sent before jobs, decayvoices starts the job
 void proposals::decayvoice(uint64_t start, uint64_t chunksize) {
   require_auth(get_self());
+  start_job(decay_voice_job, chunksize, 0, start);
+}
 
+job::progress proposals::decay_voice_chunk(uint64_t start, uint64_t chunksize) {
   voice_tables voice_alliance(get_self(), alliance_type.value);
 
   uint64_t percentage_decay = config_get(name("vdecayprntge"));
@@ -629,20 +656,11 @@ void proposals::decayvoice(uint64_t start, uint64_t chunksize) {
     count++;
   }
 
-  if (vitr != voice.end()) {
-    uint64_t next_value = vitr->account.value;
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "decayvoice"_n,
-        std::make_tuple(next_value, chunksize)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+  if (vitr == voice.end()) {
+    return job::progress{ 0, count, true };
   }
+
+  return job::progress{ vitr->account.value, count, false };
 }
 
 void proposals::migratevoice(uint64_t start) {
@@ -906,19 +924,18 @@ void proposals::erasepartpts(uint64_t active_proposals) {
   uint64_t reward_points = config_get(name("voterep1.ind"));
 
   uint64_t counter = 0;
+  std::vector<rep_change> rep_changes;
   auto pitr = participants.begin();
   while (pitr != participants.end() && counter < batch_size) {
     if (pitr -> count == active_proposals && pitr -> nonneutral) {
-      action(
-        permission_level{contracts::accounts, "active"_n},
-        contracts::accounts, "addrep"_n,
-        std::make_tuple(pitr -> account, reward_points)
-      ).send();
+      rep_changes.push_back(rep_change{ pitr -> account, int64_t(reward_points) });
     }
     counter += 1;
     pitr = participants.erase(pitr);
   }
 
+  send_addreps(rep_changes);
+
   if (counter == batch_size) {
     transaction trx_erase_participants{};
     trx_erase_participants.actions.emplace_back(
@@ -1248,17 +1265,14 @@ void proposals::refund_staked(name beneficiary, asset quantity) {
   withdraw(beneficiary, quantity, contracts::bank, "");
 }
 
-void proposals::change_rep(name beneficiary, bool passed) {
-  if (passed) {
-    auto reward_points = config_get(name("proppass.rep"));
-    action(
-      permission_level{contracts::accounts, "active"_n},
-      contracts::accounts, "addrep"_n,
-      std::make_tuple(beneficiary, reward_points)
-    ).send();
-
-  }
+void proposals::send_addreps(const std::vector<rep_change> & changes) {
+  if (changes.empty()) return;
 
+  action(
+    permission_level{contracts::accounts, "active"_n},
+    contracts::accounts, "addreps"_n,
+    std::make_tuple(changes)
+  ).send();
 }
 
 void proposals::send_to_escrow(name fromfund, name recipient, asset quantity, string memo) {
@@ -1297,6 +1311,14 @@ void proposals::withdraw(name beneficiary, asset quantity, name sender, string m
   action.send(sender, beneficiary, quantity, memo);
 }
 
+void proposals::withdraw_many(name sender, const std::vector<token::payout> & payouts, string memo)
+{
+  if (payouts.empty()) return;
+
+  token::transfermany_action action{contracts::token, {sender, "active"_n}};
+  action.send(sender, payouts, memo);
+}
+
 void proposals::burn(asset quantity)
 {
   utils::check_asset(quantity);
@@ -1372,42 +1394,11 @@ void proposals::recover_voice(name account) {
 }
 
 void proposals::size_change(name id, int64_t delta) {
-  size_tables sizes(get_self(), get_self().value);
-
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    check(delta >= 0, "can't add negagtive size");
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = delta;
-    });
-  } else {
-    uint64_t newsize = sitr->size + delta; 
-    if (delta < 0) {
-      if (sitr->size < -delta) {
-        newsize = 0;
-      }
-    }
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = newsize;
-    });
-  }
+  sizes.change(id, delta);
 }
 
 void proposals::size_set(name id, int64_t value) {
-  size_tables sizes(get_self(), get_self().value);
-
-  auto sitr = sizes.find(id.value);
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = id;
-      item.size = value;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = value;
-    });
-  }
+  sizes.set(id, value);
 }
 
 void proposals::testvdecay(uint64_t timestamp) {
@@ -1447,19 +1438,7 @@ ACTION proposals::initnumprop() {
     pitr++;
   }
 
-  size_tables sizes(get_self(), get_self().value);
-  auto sitr = sizes.find(prop_active_size.value);
-
-  if (sitr == sizes.end()) {
-    sizes.emplace(_self, [&](auto& item) {
-      item.id = prop_active_size;
-      item.size = total_proposals;
-    });
-  } else {
-    sizes.modify(sitr, _self, [&](auto& item) {
-      item.size = total_proposals;
-    });
-  }
+  size_set(prop_active_size, total_proposals);
 }
 
 void proposals::check_voice_scope (name scope) {
@@ -72,22 +72,13 @@ void scheduler::reset_aux(bool destructive) {
         name("tokn.resetw"),
 
         name("acct.rankrep"),
-        name("acct.rankcbs"),
 
-        name("hrvst.ranktx"),
-        name("hrvst.rankpl"),
-
-        name("hrvst.calccs"), // after the above 4
-        name("hrvst.rankcs"), 
-        name("hrvst.calctx"), // 24h
-        name("hrvst.biocs"),
+        name("hrvst.scores"), // after the above - tx points, planted ranks, contribution scores and their ranks
 
         name("org.clndaus"),
         name("org.rankregn"),
         name("org.rankcbs"),
 
-        name("hrvst.orgtxs"),
-
         name("prop.dvoices"),
 
         name("forum.rank"),
@@ -103,22 +94,13 @@ void scheduler::reset_aux(bool destructive) {
         name("resetweekly"),
 
         name("rankreps"),
-        name("rankcbss"),
         
-        name("ranktxs"),
-        name("rankplanteds"),
-
-        name("calccss"),
-        name("rankcss"),
-        name("calctrxpts"),
-        name("rankbiocss"),
+        name("calcscores"),
 
         name("cleandaus"),
         name("rankregens"),
         name("rankcbsorgs"),
 
-        name("rankorgtxs"),
-
         name("decayvoices"),
 
         name("rankforums"),
@@ -133,23 +115,14 @@ void scheduler::reset_aux(bool destructive) {
         contracts::exchange,
         contracts::token,
 
-        contracts::accounts,
         contracts::accounts,
 
-        contracts::harvest,
-        contracts::harvest,
-
-        contracts::harvest,
-        contracts::harvest,
-        contracts::harvest,
         contracts::harvest,
 
         contracts::organization,
         contracts::organization,
         contracts::organization,
 
-        contracts::harvest,
-
         contracts::proposals,
 
         contracts::forum,
@@ -164,23 +137,14 @@ void scheduler::reset_aux(bool destructive) {
         utils::seconds_per_day * 7,
         utils::seconds_per_day * 7,
 
-        utils::seconds_per_hour,
         utils::seconds_per_hour,
 
-        utils::seconds_per_hour,
         utils::seconds_per_hour,
 
-        utils::seconds_per_hour,
-        utils::seconds_per_hour,
-        utils::seconds_per_day,
-        utils::seconds_per_day,
-
         utils::seconds_per_day / 2,
         utils::seconds_per_day,
         utils::seconds_per_day,
 
-        utils::seconds_per_day,
-
         utils::seconds_per_day,
         
         utils::moon_cycle / 4,
@@ -197,16 +161,9 @@ void scheduler::reset_aux(bool destructive) {
         now,
         now,
 
-        now - utils::seconds_per_hour, 
-        now - utils::seconds_per_hour, 
-
-        now - utils::seconds_per_hour, 
         now - utils::seconds_per_hour, 
 
         now + 300 - utils::seconds_per_hour, // kicks off 5 minutes later
-        now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
-        now,
-        now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
 
         now,
         now,
@@ -214,8 +171,6 @@ void scheduler::reset_aux(bool destructive) {
 
         now,
 
-        now,
-
         now,
         now - utils::seconds_per_hour,
 
@@ -301,6 +301,8 @@ void settings::configure(name param, uint64_t value) {
       item.value = value;
     });
   }
+
+  snapshot(param, value);
 }
 
 void settings::conffloat(name param, double value) {
@@ -322,6 +324,8 @@ void settings::conffloat(name param, double value) {
       item.value = value;
     });
   }
+
+  snapshot_float(param, value);
 }
 
 void settings::confwithdesc(name param, uint64_t value, string description, name impact) {
@@ -347,6 +351,8 @@ void settings::confwithdesc(name param, uint64_t value, string description, name
       item.impact = impact;
     });
   }
+
+  snapshot(param, value);
 }
 
 void settings::conffloatdsc(name param, double value, string description, name impact) {
@@ -372,6 +378,8 @@ void settings::conffloatdsc(name param, double value, string description, name i
       item.impact = impact;
     });
   }
+
+  snapshot_float(param, value);
 }
 
 void settings::setcontract(name contract, name account) {
@@ -391,3 +399,45 @@ void settings::setcontract(name contract, name account) {
     });
   }
 }
+
+void settings::initsnap() {
+  require_auth(get_self());
+
+  for (auto citr = config.begin(); citr != config.end(); citr++) {
+    snapshot(citr->param, citr->value);
+  }
+
+  for (auto fitr = configfloat.begin(); fitr != configfloat.end(); fitr++) {
+    snapshot_float(fitr->param, fitr->value);
+  }
+}
+
+void settings::snapshot(name param, uint64_t value) {
+  auto sitr = configsnap.find(param.value);
+
+  if (sitr == configsnap.end()) {
+    configsnap.emplace(_self, [&](auto& item) {
+      item.param = param;
+      item.value = value;
+    });
+  } else if (sitr->value != value) {
+    configsnap.modify(sitr, _self, [&](auto& item) {
+      item.value = value;
+    });
+  }
+}
+
+void settings::snapshot_float(name param, double value) {
+  auto sitr = configfloatsnap.find(param.value);
+
+  if (sitr == configfloatsnap.end()) {
+    configfloatsnap.emplace(_self, [&](auto& item) {
+      item.param = param;
+      item.value = value;
+    });
+  } else if (sitr->value != value) {
+    configfloatsnap.modify(sitr, _self, [&](auto& item) {
+      item.value = value;
+    });
+  }
+}
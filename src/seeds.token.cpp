@@ -129,6 +129,43 @@ void token::transfer( const name&    from,
     update_stats( from, to, quantity );
 }
 
+void token::transfermany( const name&                 from,
+                          const std::vector<payout>&  payouts,
+                          const string&               memo )
+{
+    require_auth( from );
+    check( !payouts.empty(), "seeds: no payouts" );
+    check( memo.size() <= 256, "seeds: memo has more than 256 bytes" );
+
+    user_tables users(contracts::accounts, contracts::accounts.value);
+    userstatus_tables statuses(contracts::accounts, contracts::accounts.value);
+    name status, type;
+    check( !userstatus::find(statuses, users, from, status, type), "seeds: users can't use transfermany" );
+
+    auto sym = payouts[0].quantity.symbol;
+    stats statstable( get_self(), sym.code().raw() );
+    const auto& st = statstable.get( sym.code().raw(), "seeds: token with symbol does not exist" );
+
+    require_recipient( from );
+
+    asset total = asset( 0, st.supply.symbol );
+
+    for (const auto & p : payouts) {
+      check( p.to != from, "seeds: cannot transfer to self" );
+      check( is_account( p.to ), "seeds: to account does not exist");
+      check( p.quantity.is_valid(), "seeds: invalid quantity" );
+      check( p.quantity.amount > 0, "seeds: must transfer positive quantity" );
+      check( p.quantity.symbol == st.supply.symbol, "seeds: symbol precision mismatch" );
+
+      require_recipient( p.to );
+
+      add_balance( p.to, p.quantity, from );
+      total += p.quantity;
+    }
+
+    sub_balance( from, total );
+}
+
 void token::sub_balance( const name& owner, const asset& value ) {
    accounts from_acnts( get_self(), owner.value );
 
@@ -173,20 +210,19 @@ void token::save_transaction(name from, name to, asset quantity) {
 
 void token::check_limit_transactions(name from) {
   user_tables users(contracts::accounts, contracts::accounts.value);
-  config_tables config(contracts::settings, contracts::settings.value);
-  balance_tables balances(contracts::harvest, contracts::harvest.value);
+  userstatus_tables statuses(contracts::accounts, contracts::accounts.value);
+  planted_tables planted(contracts::harvest, contracts::harvest.value);
 
-  auto bitr = balances.find(from.value);
-  auto uitr = users.find(from.value);
+  name status, type;
 
-  if (uitr != users.end()) {
+  if (userstatus::find(statuses, users, from, status, type)) {
+    auto pitr = planted.find(from.value);
     uint64_t max_trx = 0;
-    if (bitr != balances.end() && bitr -> planted > asset(0, seeds_symbol)) {
-      auto mul_trx = config.get(name("txlimit.mul").value, "The txlimit.mul parameters has not been initialized yet.");
-      max_trx = (mul_trx.value * (bitr -> planted).amount) / 10000;
+    if (pitr != planted.end() && pitr -> planted > asset(0, seeds_symbol)) {
+      uint64_t mul_trx = config_snapshot::get(name("txlimit.mul"));
+      max_trx = (mul_trx * (pitr -> planted).amount) / 10000;
     } else {
-      auto min_trx = config.get(name("txlimit.min").value, "The txlimit.min parameters has not been initialized yet.");
-      max_trx = min_trx.value;
+      max_trx = config_snapshot::get(name("txlimit.min"));
     }
 
     transaction_tables transactions(get_self(), seeds_symbol.code().raw());
@@ -200,14 +236,14 @@ void token::check_limit_transactions(name from) {
 
 void token::check_limit(const name& from) {
   user_tables users(contracts::accounts, contracts::accounts.value);
-  auto uitr = users.find(from.value);
+  userstatus_tables statuses(contracts::accounts, contracts::accounts.value);
+
+  name status, type;
 
-  if (uitr == users.end()) {
+  if (!userstatus::find(statuses, users, from, status, type)) {
     return;
   }
 
-  name status = uitr->status;
-
   uint64_t limit = 10;
   if (status == "resident"_n) {
     limit = 50;
@@ -227,13 +263,22 @@ void token::reset_weekly_aux(uint64_t begin) {
   config_tables config(contracts::settings, contracts::settings.value);
 
   auto batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet.");
+
+  uint64_t run = job::start(jobs, get_self(), reset_weekly_job, batch_size.value, 0, begin);
+  if (run > 0) {
+    jobstep(reset_weekly_job, run);
+  }
+
+}
+
+job::progress token::reset_weekly_chunk(uint64_t begin, uint64_t chunksize) {
   auto sym_code_raw = seeds_symbol.code().raw();
   uint64_t count = 0;
 
   transaction_tables transactions(get_self(), sym_code_raw);
 
   auto titr = begin == 0 ? transactions.begin() : transactions.lower_bound(begin);
-  while (titr != transactions.end() && count < batch_size.value) {
+  while (titr != transactions.end() && count < chunksize) {
     transactions.modify(titr, _self, [&](auto& user) {
       user.incoming_transactions = 0;
       user.outgoing_transactions = 0;
@@ -244,18 +289,11 @@ void token::reset_weekly_aux(uint64_t begin) {
     count++;
   }
 
-  if (titr != transactions.end()) {
-    transaction trx{};
-    trx.actions.emplace_back(
-      permission_level(_self, "active"_n),
-      _self,
-      "resetwhelper"_n,
-      std::make_tuple((titr -> account).value)
-    );
-    trx.delay_sec = 1;
-    trx.send(eosio::current_time_point().sec_since_epoch(), _self);
+  if (titr == transactions.end()) {
+    return job::progress{ 0, count, true };
   }
 
+  return job::progress{ (titr -> account).value, count, false };
 }
 
 void token::resetweekly() {
@@ -263,18 +301,29 @@ void token::resetweekly() {
   reset_weekly_aux((uint64_t)0);
 }
 
+// resets from begin on - from deferred transactions sent before jobs, resetweekly starts the job
 void token::resetwhelper (uint64_t begin) {
   require_auth(get_self());
   reset_weekly_aux(begin);
 }
 
+void token::jobstep(name job, uint64_t run) {
+  require_auth(get_self());
+
+  job::step(jobs, get_self(), job, run, [&](const auto & item) {
+    check(job == reset_weekly_job, "unknown job " + job.to_string());
+    return reset_weekly_chunk(uint64_t(item.cursor), item.chunksize);
+  });
+}
+
 void token::update_stats( const name& from, const name& to, const asset& quantity ) {
     user_tables users(contracts::accounts, contracts::accounts.value);
+    userstatus_tables statuses(contracts::accounts, contracts::accounts.value);
 
-    auto fromuser = users.find(from.value);
-    auto touser = users.find(to.value);
-    
-    if (fromuser == users.end() || touser == users.end()) {
+    name from_status, from_type, to_status, to_type;
+
+    if (!userstatus::find(statuses, users, from, from_status, from_type) ||
+        !userstatus::find(statuses, users, to, to_status, to_type)) {
       return;
     }
 
@@ -439,4 +488,4 @@ void token::minttst (const name& to, const asset& quantity, const string& memo)
 
 } /// namespace eosio
 
-EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(open)(close)(retire)(burn)(resetweekly)(resetwhelper)(updatecirc)(minttst) )
+EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(transfermany)(open)(close)(retire)(burn)(resetweekly)(resetwhelper)(jobstep)(updatecirc)(minttst) )
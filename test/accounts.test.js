@@ -192,12 +192,35 @@ describe('General accounts', async assert => {
     json: true
   })
 
+  const repRows = await eos.getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'rep',
+    json: true
+  })
+
   console.log('test citizen second user')
   await contract.testcitizen(seconduser, { authorization: `${accounts}@active` })
 
+  const getRefCounts = async () => (await eos.getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'refcounts',
+    json: true
+  })).rows
+
+  const refCounts = await getRefCounts()
+
+  console.log('recount referrals')
+  await contract.initrefcnt(0, 1, { authorization: `${accounts}@active` })
+
+  const refCountsRecounted = await getRefCounts()
+
   console.log('test testremove')
   await contract.testremove(seconduser, { authorization: `${accounts}@active` })
 
+  const refCountsAfterRemove = await getRefCounts()
+
   const usersAfterRemove = await eos.getTableRows({
     code: accounts,
     scope: accounts,
@@ -255,9 +278,16 @@ describe('General accounts', async assert => {
 
   assert({
     given: 'changed reputation',
-    should: 'have correct values',
+    should: 'have correct values in the rep table',
+    actual: repRows.rows.filter(({ account }) => account == firstuser).map(({ rep }) => rep),
+    expected: [101]
+  })
+
+  assert({
+    given: 'changed reputation',
+    should: 'not write the deprecated users.reputation',
     actual: users.rows.map(({ reputation }) => reputation),
-    expected: [101, 0, 0]
+    expected: [0, 0, 0]
   })
 
   assert({
@@ -277,6 +307,27 @@ describe('General accounts', async assert => {
     }
   })
 
+  assert({
+    given: 'invited user became citizen',
+    should: 'be counted for the referrer',
+    actual: refCounts,
+    expected: [{ referrer: firstuser, invited: 1, residents: 0, citizens: 1 }]
+  })
+
+  assert({
+    given: 'referrals counted again',
+    should: 'have the same counters',
+    actual: refCountsRecounted,
+    expected: refCounts
+  })
+
+  assert({
+    given: 'invited user removed',
+    should: 'not be counted as citizen',
+    actual: refCountsAfterRemove,
+    expected: [{ referrer: firstuser, invited: 1, residents: 0, citizens: 0 }]
+  })
+
   assert({
     given: 'users table',
     should: 'show joined users',
@@ -285,7 +336,7 @@ describe('General accounts', async assert => {
       account: firstuser,
       status: 'citizen',
       nickname: 'Ricky G',
-      reputation: 101,
+      reputation: 0,
     }, {
       account: seconduser,
       status: 'resident',
@@ -463,6 +514,28 @@ describe('vouching', async assert => {
   await checkReps([2, 10, 5], `${seconduser} vouched`, "have the correct rep")
   await checkVouch(5, `${firstuser} unvouched`, 'store the vouch')
 
+  const getVouchTotals = async () => (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'vouchtotals',
+    json: true
+  })).rows
+
+  const vouchTotals = await getVouchTotals()
+
+  console.log('audit vouch totals')
+  for (const user of [firstuser, seconduser, thirduser, fourthuser]) {
+    await contract.auditvouch(user, { authorization: `${accounts}@active` })
+  }
+
+  assert({
+    given: 'vouch points summed up again',
+    should: 'match the totals kept on vouch, unvouch and punish',
+    actual: await getVouchTotals(),
+    expected: vouchTotals
+  })
+  await checkReps([2, 10, 5], 'vouch totals audited', "have the same rep")
+
 })
 
 describe('test vouch migration', async assert => {
@@ -1033,7 +1106,7 @@ describe('make citizen test', async assert => {
     scope: harvest,
     lower_bound: firstuser,
     upper_bound: firstuser,
-    table: 'balances',
+    table: 'planted',
     json: true,
   })
 
@@ -1055,6 +1128,53 @@ describe('make citizen test', async assert => {
 
 })
 
+describe('batched reputation changes', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users')
+  await contracts.accounts.adduser(firstuser, 'First user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, 'Second user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, '3 user', "individual", { authorization: `${accounts}@active` })
+
+  await contracts.accounts.addrep(thirduser, 5, { authorization: `${accounts}@api` })
+
+  console.log('add reps')
+  await contracts.accounts.addreps([
+    { account: firstuser, delta: 10 },
+    { account: seconduser, delta: 5 },
+    { account: firstuser, delta: -3 },
+    { account: thirduser, delta: -5 },
+    { account: seconduser, delta: 0 },
+  ], { authorization: `${accounts}@api` })
+
+  const reps = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'rep',
+    json: true
+  })
+
+  assert({
+    given: 'rep changes of several accounts, some for the same account',
+    should: 'apply the sum per account',
+    actual: reps.rows.map(({ account, rep }) => ({ account, rep })),
+    expected: [
+      { account: firstuser, rep: 7 },
+      { account: seconduser, rep: 5 },
+    ]
+  })
+
+})
+
 describe('reputation & cbs ranking', async assert => {
 
   if (!isLocal()) {
@@ -1247,6 +1367,420 @@ describe('reputation & cbs ranking', async assert => {
 
 })
 
+describe('reputation ranking snapshot', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users')
+  const users = [firstuser, seconduser, thirduser, fourthuser, fifthuser]
+  for (let i = 0; i < users.length; i++) {
+    await contracts.accounts.adduser(users[i], 'user ' + i, "individual", { authorization: `${accounts}@active` })
+    await contracts.accounts.testsetrep(users[i], (i + 1) * 10, { authorization: `${accounts}@active` })
+  }
+
+  const getRep = async (user) => {
+    const rep = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'rep',
+      lower_bound: user,
+      upper_bound: user,
+      json: true
+    })
+    return rep.rows[0].rep
+  }
+
+  console.log('rank rep 1 per chunk, change rep while ranking')
+  await contracts.accounts.rankrep(0, 0, 1, { authorization: `${accounts}@active` })
+
+  await contracts.accounts.addrep(firstuser, 100, { authorization: `${accounts}@api` })
+  await contracts.accounts.subrep(fifthuser, 45, { authorization: `${accounts}@api` })
+
+  const repDuringRanking = await getRep(firstuser)
+
+  const deltas = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'repdelta',
+    json: true
+  })
+
+  await sleep(10000)
+
+  const repsAfter = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'rep',
+    json: true
+  })
+
+  const deltasAfter = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'repdelta',
+    json: true
+  })
+
+  const repAfterRanking = await getRep(firstuser)
+  const fifthRepAfterRanking = await getRep(fifthuser)
+
+  assert({
+    given: 'rep added while ranking',
+    should: 'not change rep until ranking is done',
+    actual: repDuringRanking,
+    expected: 10
+  })
+
+  assert({
+    given: 'rep changed while ranking',
+    should: 'stage the changes',
+    actual: deltas.rows.map(({ delta }) => delta).sort((a, b) => a - b),
+    expected: [-45, 100]
+  })
+
+  assert({
+    given: 'rep changed while ranking',
+    should: 'rank the snapshot taken at the start',
+    actual: users.map(user => repsAfter.rows.find(row => row.account == user).rank),
+    expected: [0, 20, 40, 60, 80]
+  })
+
+  assert({
+    given: 'ranking done',
+    should: 'apply staged changes',
+    actual: [repAfterRanking, fifthRepAfterRanking, deltasAfter.rows.length],
+    expected: [110, 5, 0]
+  })
+
+})
+
+describe('reputation rank boxes', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts, settings })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('reset settings')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('add citizens with rep')
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+  for (let i = 0; i < users.length; i++) {
+    await contracts.accounts.adduser(users[i], 'user ' + i, "individual", { authorization: `${accounts}@active` })
+    await contracts.accounts.testcitizen(users[i], { authorization: `${accounts}@active` })
+    await contracts.accounts.testsetrep(users[i], (i + 1) * 10, { authorization: `${accounts}@active` })
+  }
+
+  console.log('rebuild rank boxes 1 per chunk')
+  await contracts.accounts.initrepbox(0, 1, { authorization: `${accounts}@active` })
+  await sleep(6000)
+
+  console.log('evaluate demotion')
+  await contracts.accounts.evaldemote(seconduser, 0, 0, 0, { authorization: `${accounts}@active` })
+  await contracts.accounts.evaldemote(fourthuser, 0, 0, 0, { authorization: `${accounts}@active` })
+
+  const reps = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'rep',
+    json: true
+  })
+
+  const usersTable = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'users',
+    json: true
+  })
+
+  const rankOf = user => reps.rows.find(row => row.account == user).rank
+  const statusOf = user => usersTable.rows.find(row => row.account == user).status
+
+  assert({
+    given: 'evaldemote on 2nd and 4th lowest rep',
+    should: 'rank them without walking the rep table',
+    actual: [rankOf(seconduser), rankOf(fourthuser)],
+    expected: [25, 75]
+  })
+
+  assert({
+    given: 'rank below citizen and resident threshold',
+    should: 'be demoted, others stay',
+    actual: users.map(statusOf),
+    expected: ['citizen', 'visitor', 'citizen', 'citizen']
+  })
+
+})
+
+describe('cbs rank boxes', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users with cbs')
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+  for (let i = 0; i < users.length; i++) {
+    await contracts.accounts.adduser(users[i], 'user ' + i, 'individual', { authorization: `${accounts}@active` })
+    await contracts.accounts.testsetcbs(users[i], 10 * (i + 1), { authorization: `${accounts}@active` })
+  }
+
+  const getRanks = async () => {
+    const cbs = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'cbs',
+      json: true
+    })
+    return users.map(user => cbs.rows.find(row => row.account == user).rank)
+  }
+
+  const ranksOnChange = await getRanks()
+
+  console.log('hourly ranking pass')
+  await contracts.accounts.rankcbss({ authorization: `${accounts}@active` })
+
+  const jobs = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'jobs',
+    lower_bound: 'rankcbs',
+    upper_bound: 'rankcbs',
+    json: true
+  })
+
+  console.log('rebuild rank boxes 1 per chunk')
+  await contracts.accounts.initcbsbox(0, 1, { authorization: `${accounts}@active` })
+  await sleep(6000)
+
+  console.log('first user moves to the top')
+  await contracts.accounts.testsetcbs(firstuser, 50, { authorization: `${accounts}@active` })
+
+  const ranksAfter = await getRanks()
+
+  assert({
+    given: 'cbs set in order of the score',
+    should: 'rank each account when its score changes',
+    actual: ranksOnChange,
+    expected: [0, 50, 66, 75]
+  })
+
+  assert({
+    given: 'rank boxes filled',
+    should: 'not start a ranking pass',
+    actual: jobs.rows.length,
+    expected: 0
+  })
+
+  assert({
+    given: 'highest score after rebuilding the boxes',
+    should: 'rank above the other 3, others keep their rank',
+    actual: ranksAfter,
+    expected: [75, 50, 66, 75]
+  })
+
+})
+
+describe('user status table', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts, settings })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('reset settings')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('add users')
+  await contracts.accounts.adduser(firstuser, 'First user', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, 'Second user', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(orguser, 'Org', 'organisation', { authorization: `${accounts}@active` })
+
+  console.log('change status')
+  await contracts.accounts.testresident(firstuser, { authorization: `${accounts}@active` })
+  await contracts.accounts.testcitizen(seconduser, { authorization: `${accounts}@active` })
+
+  console.log('update profile')
+  await contracts.accounts.update(firstuser, 'individual', 'First', 'image', 'story', 'roles', 'skills', 'interests', { authorization: `${firstuser}@active` })
+
+  const getStatuses = async () => {
+    const statuses = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'userstatus',
+      json: true
+    })
+    return statuses.rows.map(({ account, status, type }) => ({ account, status, type }))
+  }
+
+  const statuses = await getStatuses()
+
+  console.log('remove user')
+  await contracts.accounts.testremove(seconduser, { authorization: `${accounts}@active` })
+
+  const statusesAfterRemove = await getStatuses()
+
+  const byAccount = (a, b) => a.account < b.account ? -1 : 1
+
+  assert({
+    given: 'users added and status changed',
+    should: 'keep status and type in the userstatus table',
+    actual: statuses.sort(byAccount),
+    expected: [
+      { account: firstuser, status: 'resident', type: 'individual' },
+      { account: orguser, status: 'visitor', type: 'organisation' },
+      { account: seconduser, status: 'citizen', type: 'individual' }
+    ].sort(byAccount)
+  })
+
+  assert({
+    given: 'user removed',
+    should: 'remove the userstatus row',
+    actual: statusesAfterRemove.map(({ account }) => account).sort(),
+    expected: [firstuser, orguser].sort()
+  })
+
+})
+
+describe('size counters', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  const getTestSize = async () => {
+    const sizes = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'sizes',
+      json: true
+    })
+    return sizes.rows.filter(({ id }) => id == 'test.sz').map(({ size }) => size)
+  }
+
+  console.log('change size')
+  await contracts.accounts.changesize('test.sz', 5, { authorization: `${accounts}@active` })
+  await contracts.accounts.changesize('test.sz', 3, { authorization: `${accounts}@active` })
+  const afterAdd = await getTestSize()
+
+  await contracts.accounts.changesize('test.sz', -2, { authorization: `${accounts}@active` })
+  const afterSub = await getTestSize()
+
+  await contracts.accounts.changesize('test.sz', -20, { authorization: `${accounts}@active` })
+  const afterUnderflow = await getTestSize()
+
+  assert({
+    given: 'size changed by positive and negative deltas',
+    should: 'add them up, never going below 0',
+    actual: [afterAdd, afterSub, afterUnderflow],
+    expected: [[8], [6], [0]]
+  })
+
+})
+
+describe('ranking jobs', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users with cbs')
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+  for (let i = 0; i < users.length; i++) {
+    await contracts.accounts.adduser(users[i], 'user ' + i, 'individual', { authorization: `${accounts}@active` })
+    await contracts.accounts.testsetcbs(users[i], 10 * (i + 1), { authorization: `${accounts}@active` })
+  }
+
+  const getJob = async () => {
+    const jobs = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'jobs',
+      lower_bound: 'rankcbs',
+      upper_bound: 'rankcbs',
+      json: true
+    })
+    return jobs.rows[0]
+  }
+
+  console.log('rank cbs 1 per chunk')
+  await contracts.accounts.rankcbs(0, 0, 1, { authorization: `${accounts}@active` })
+  const jobStarted = await getJob()
+
+  console.log('start again while running')
+  await contracts.accounts.rankcbss({ authorization: `${accounts}@active` })
+  const jobStartedAgain = await getJob()
+
+  await sleep(5000)
+  const jobDone = await getJob()
+
+  const cbs = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'cbs',
+    json: true
+  })
+
+  assert({
+    given: 'ranking started with chunk size 1',
+    should: 'run as job',
+    actual: [jobStarted.status, jobStarted.run, jobStarted.processed, jobStarted.chunksize],
+    expected: ['running', 1, 1, 1]
+  })
+
+  assert({
+    given: 'ranking started while running',
+    should: 'keep the running job',
+    actual: [jobStartedAgain.status, jobStartedAgain.run, jobStartedAgain.max_chunksize],
+    expected: ['running', 1, 1]
+  })
+
+  assert({
+    given: 'ranking job done',
+    should: 'have ranked all entries',
+    actual: [jobDone.status, jobDone.run, jobDone.processed, cbs.rows.map(({ rank }) => rank).sort((a, b) => a - b)],
+    expected: ['done', 1, 4, [0, 25, 50, 75]]
+  })
+
+})
+
 describe('Referral cbp reward individual', async assert => {
 
 
@@ -1631,6 +2165,21 @@ describe('Punishment', async assert => {
     })
   }
 
+  const checkPunishments = async (expected) => {
+    const punishments = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'punishments',
+      json: true
+    })
+    assert({
+      given: 'punishment done',
+      should: 'not be queued anymore',
+      actual: punishments.rows,
+      expected
+    })
+  }
+
   console.log('change resident threshold')
   await contracts.settings.configure('res.rep.pt', 10, { authorization: `${settings}@active` })
 
@@ -1695,12 +2244,14 @@ describe('Punishment', async assert => {
     console.log('only residents or citizens (expected)')
   }
 
-  await sleep(2000)
+  // one punishment step a second, batchsize 1: rep, status and the first voucher, then the second voucher
+  await sleep(3000)
 
   await checkFlags(firstuser, 46)
   await checkPunishmentPoints(firstuser, 46)
   await checkReps([24, 77, 177, 300, 6])
   await checkUserStatus(firstuser, 'resident')
+  await checkPunishments([])
 
   console.log('remove flag')
   await contracts.accounts.removeflag(seconduser, firstuser, { authorization: `${seconduser}@active` })
@@ -1714,12 +2265,13 @@ describe('Punishment', async assert => {
   await contracts.accounts.flag(seconduser, firstuser, { authorization: `${seconduser}@active` })
   await contracts.accounts.flag(thirduser, firstuser, { authorization: `${thirduser}@active` })
 
-  await sleep(1500)
+  await sleep(3000)
 
   await checkFlags(firstuser, 70) // -24
   await checkPunishmentPoints(firstuser, 70)
   await checkReps([65, 165, 300, 6])
   await checkUserStatus(firstuser, 'visitor')
+  await checkPunishments([])
 
   console.log('flag a user without rep')
   await contracts.accounts.testcitizen(fifthuser, { authorization: `${accounts}@active` })
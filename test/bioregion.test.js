@@ -383,9 +383,22 @@ describe("Bioregions Test Delete", async assert => {
   await contracts.bioregion.addrole(bioname, firstuser, thirduser, "admin", { authorization: `${firstuser}@active` })
   await contracts.bioregion.addrole(bioname2, seconduser, fourthuser, "admin", { authorization: `${seconduser}@active` })
 
+  const getBioregionsSize = async () => {
+    const sizes = await getTableRows({
+      code: bioregion,
+      scope: bioregion,
+      table: 'sizes',
+      lower_bound: 'bios.sz',
+      upper_bound: 'bios.sz',
+      json: true
+    })
+    return sizes.rows.map(({ size }) => size)
+  }
+
   const membersBefore = await getMembers()
   const roles1before = await getRoles(bioname)
   const roles2before = await getRoles(bioname2)
+  const sizeBefore = await getBioregionsSize()
 
   // console.log("membersBefore "+JSON.stringify(membersBefore, null, 2))
   // console.log("roles1before "+JSON.stringify(roles1before, null, 2))
@@ -396,6 +409,7 @@ describe("Bioregions Test Delete", async assert => {
   const roles1After = await getRoles(bioname)
   const roles2After = await getRoles(bioname2)
   const membersAfter = await getMembers()
+  const sizeAfter = await getBioregionsSize()
 
   // console.log("membersAfter "+JSON.stringify(membersAfter, null, 2))
   // console.log("roles2After "+JSON.stringify(roles2After, null, 2))
@@ -422,5 +436,12 @@ assert({
   expected: 2
 })
 
+assert({
+  given: 'create 2 bioregions and remove 1',
+  should: 'count the bioregions',
+  actual: [sizeBefore, sizeAfter],
+  expected: [[2], [1]]
+})
+
 
 })
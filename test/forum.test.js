@@ -350,10 +350,10 @@ describe('forum reputation', async assert => {
     await contracts.forum.givereps({ authorization: `${forum}@active` })
     await sleep(300)
 
-    const users = await getTableRows({
+    const reps = await getTableRows({
         code: accounts,
         scope: accounts,
-        table: 'users',
+        table: 'rep',
         json: true
     })
 
@@ -388,7 +388,7 @@ describe('forum reputation', async assert => {
         given: 'reputation distributed',
         should: 'give users correct reputation',
         expected: [10000, 5006, 10003],
-        actual: users.rows.map(u => u.reputation)
+        actual: reps.rows.map(r => r.rep)
     })
 })
 
@@ -115,7 +115,7 @@ describe("Harvest General", async assert => {
   const refundsAfterUnplanted = await getTableRows({
     code: harvest,
     scope: seconduser,
-    table: 'refunds',
+    table: 'refundscheds',
     json: true,
     limit: 100
   })
@@ -208,7 +208,7 @@ describe("Harvest General", async assert => {
     }
   }
 
-  const totalUnplanted = refundsAfterUnplanted.rows.reduce( (a, b) => a + assetIt(b.amount).amount, 0) / 10000
+  const totalUnplanted = refundsAfterUnplanted.rows.reduce( (a, b) => a + assetIt(b.total).amount, 0) / 10000
 
   console.log('claim refund\n')
   const balanceBeforeClaimed = await getBalanceFloat(seconduser)
@@ -224,7 +224,7 @@ describe("Harvest General", async assert => {
   const refundsAfterClaimed = await getTableRows({
     code: harvest,
     scope: seconduser,
-    table: 'refunds',
+    table: 'refundscheds',
     json: true,
     limit: 100
   })
@@ -250,7 +250,7 @@ describe("Harvest General", async assert => {
   const refundsAfterCanceled = await getTableRows({
     code: harvest,
     scope: seconduser,
-    table: 'refunds',
+    table: 'refundscheds',
     json: true,
     limit: 100
   })
@@ -342,23 +342,23 @@ describe("Harvest General", async assert => {
 
   assert({
     given: 'after unplanting 100 seeds',
-    should: 'refund rows add up to 100',
+    should: 'refund schedule add up to 100',
     actual: totalUnplanted,
     expected: 100
   })
 
   assert({
     given: 'unplant called',
-    should: 'create refunds rows',
+    should: 'create one refund schedule row',
     actual: refundsAfterUnplanted.rows.length,
-    expected: 12
+    expected: 1
   })
 
   assert({
     given: 'claimed refund',
-    should: 'keep refunds rows',
-    actual: refundsAfterClaimed.rows.length,
-    expected: 10
+    should: 'keep the schedule with the claimed amount',
+    actual: refundsAfterClaimed.rows.map(({ claimed, cancelled }) => [claimed, cancelled]),
+    expected: [[(Math.floor(num_seeds_unplanted * 10000 / 12) * weeks_expired / 10000).toFixed(4) + ' SEEDS', '0.0000 SEEDS']]
   })
 
   assert({
@@ -460,6 +460,69 @@ describe("harvest planted score", async assert => {
 
 })
 
+describe("harvest planted rank boxes", async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts, token, harvest, settings })
+
+  console.log('harvest reset')
+  await contracts.harvest.reset({ authorization: `${harvest}@active` })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('reset token stats')
+  await contracts.token.resetweekly({ authorization: `${token}@active` })
+
+  console.log('join users')
+  await contracts.accounts.adduser(firstuser, 'first user', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, 'second user', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, 'third user', 'individual', { authorization: `${accounts}@active` })
+
+  console.log('plant seeds')
+  await contracts.token.transfer(firstuser, harvest, '500.0000 SEEDS', '', { authorization: `${firstuser}@active` })
+  await contracts.token.transfer(seconduser, harvest, '200.0000 SEEDS', '', { authorization: `${seconduser}@active` })
+  await contracts.token.transfer(thirduser, harvest, '100.0000 SEEDS', '', { authorization: `${thirduser}@active` })
+
+  console.log('sow seeds')
+  await contracts.harvest.sow(firstuser, thirduser, '450.0000 SEEDS', { authorization: `${firstuser}@active` })
+
+  const getPlanted = async () => eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'planted',
+    json: true,
+    limit: 100
+  })
+
+  const plantedAfterSow = await getPlanted()
+
+  console.log('run the scoring cycle - the first one after a reset visits all users')
+  await contracts.harvest.calcscores({ authorization: `${harvest}@active` })
+  await sleep(8000)
+
+  const plantedAfterCalc = await getPlanted()
+
+  assert({
+    given: 'sow moved seeds to the smallest planter',
+    should: 'rank the receiver without a ranking pass',
+    actual: plantedAfterSow.rows.filter(({ account }) => account == thirduser).map(({ rank }) => rank),
+    expected: [66]
+  })
+
+  assert({
+    given: 'scoring cycle over all users',
+    should: 'refresh planted ranks from the rank boxes',
+    actual: plantedAfterCalc.rows.map(({ rank }) => rank),
+    expected: [0, 33, 66]
+  })
+
+})
+
 describe("harvest transaction score", async assert => {
 
   if (!isLocal()) {
@@ -536,6 +599,22 @@ describe("harvest transaction score", async assert => {
   console.log('calculate tx scores with reputation')
   await contracts.accounts.testsetrs(seconduser, 49, { authorization: `${accounts}@active` })
 
+  const csQueue = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'csqueue',
+    lower_bound: seconduser,
+    upper_bound: seconduser,
+    json: true
+  })
+
+  assert({
+    given: 'rep rank changed',
+    should: 'queue the account for contribution points',
+    actual: csQueue.rows,
+    expected: [{ account: seconduser }]
+  })
+
   console.log('make transaction, no reps')
   await transfer(firstuser, seconduser, 10, memoprefix)
 
@@ -572,6 +651,20 @@ describe("harvest transaction score", async assert => {
   await contracts.harvest.calccss({ authorization: `${harvest}@active` })
   await contracts.harvest.rankcss({ authorization: `${harvest}@active` })
 
+  const csQueueAfterCalc = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'csqueue',
+    json: true
+  })
+
+  assert({
+    given: 'contribution points calculated',
+    should: 'empty the queue',
+    actual: csQueueAfterCalc.rows,
+    expected: []
+  })
+
   const cspoints = await eos.getTableRows({
     code: harvest,
     scope: harvest,
@@ -609,6 +702,41 @@ describe("harvest transaction score", async assert => {
     expected: [0]
   })
 
+  console.log("run the whole scoring cycle as one job")
+  await contracts.harvest.calcscores({ authorization: `${harvest}@active` })
+  await sleep(8000)
+
+  const cspointsCycle = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'cspoints',
+    json: true,
+    limit: 100
+  })
+
+  const sumRankUsers = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'sizes',
+    lower_bound: 'usr.rnk.sz',
+    upper_bound: 'usr.rnk.sz',
+    json: true
+  })
+
+  assert({
+    given: 'scoring cycle run as one job',
+    should: 'have the same contribution scores as the separate jobs',
+    actual: cspointsCycle.rows,
+    expected: cspoints.rows
+  })
+
+  assert({
+    given: 'scoring cycle run as one job',
+    should: 'have the sum of user ranks',
+    actual: sumRankUsers.rows[0].size,
+    expected: cspoints.rows.reduce((sum, { rank }) => sum + rank, 0)
+  })
+
 })
 
 
@@ -639,7 +767,7 @@ describe("harvest community building score", async assert => {
 
     console.log("checking points "+points + " scores: "+scores)
     await sleep(300)
-    await contracts.accounts.rankcbss({ authorization: `${accounts}@active` })
+    await contracts.accounts.rankcbs(0, 0, 200, { authorization: `${accounts}@active` })
     
     const cbs = await eos.getTableRows({
       code: accounts,
@@ -683,7 +811,6 @@ describe("harvest community building score", async assert => {
   await sleep(200)
   await contracts.accounts.testsetcbs(fourthuser, 0, { authorization: `${accounts}@active` })
 
-  await contracts.accounts.rankcbss({ authorization: `${accounts}@active` })
   await checkScores([1, 2, 3, 0], [25, 50, 75, 0], "cbs distribution", "correct")
 })
 
@@ -725,7 +852,7 @@ describe("plant for other user", async assert => {
   const plantedBalances = await getTableRows({
     code: harvest,
     scope: harvest,
-    table: 'balances',
+    table: 'planted',
     upper_bound: seconduser,
     lower_bound: seconduser,
     json: true,
@@ -757,11 +884,10 @@ describe("plant for other user", async assert => {
   assert({
     given: 'user '+firstuser + 'planted for '+seconduser,
     should: 'second user should have planted balance',
-    actual: plantedBalances.rows[0],
+    actual: plantedBalances.rows.map(({ account, planted }) => ({ account, planted }))[0],
     expected: {
       "account": seconduser,
-      "planted": "77.0000 SEEDS",
-      "reward": "0.0000 SEEDS"
+      "planted": "77.0000 SEEDS"
     }
   })
   assert({
@@ -827,6 +953,23 @@ describe('Monthly QEV', async assert => {
     ]
   })
 
+  const historySizes = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'sizes',
+    json: true,
+  })
+
+  assert({
+    given: 'daily qevs for 120 days',
+    should: 'keep the qev sum of the last moon cycle in history',
+    actual: historySizes.rows.filter(r => r.id == 'qev.sum' || r.id == 'qev.sum.day'),
+    expected: [
+      { id: 'qev.sum', size: 30000000 },
+      { id: 'qev.sum.day', size: day }
+    ]
+  })
+
 })
 
 describe('Mint Rate and Harvest', async assert => {
@@ -1035,6 +1178,20 @@ describe('Mint Rate and Harvest', async assert => {
 
   await sleep(1000)
 
+  const userBalancesUnclaimed = await Promise.all(users.map(user => getTestBalance(user)))
+
+  assert({
+    given: 'harvest ran',
+    should: 'not send the user share before it is claimed',
+    actual: userBalancesUnclaimed,
+    expected: userBalancesBefore
+  })
+
+  console.log('claim harvest')
+  for (const account of [...users, ...orgs]) {
+    await contracts.harvest.claim(account, { authorization: `${account}@active` })
+  }
+
   const userBalancesAfter = await Promise.all(users.map(user => getTestBalance(user)))
   const orgBalancesAfter = await Promise.all(orgs.map(org => getTestBalance(org)))
   const bioBalancesAfter = await Promise.all(bios.map(bio => getTestBalance(bio)))
@@ -1163,8 +1320,9 @@ describe('bioregions contribution score', async assert => {
   await contracts.harvest.calctrxpts({ authorization: `${harvest}@active` })
   await contracts.harvest.ranktxs({ authorization: `${harvest}@active` })
 
-  console.log('calc contribution score')
-  await contracts.harvest.calccss({ authorization: `${harvest}@active` })
+  console.log('run the scoring cycle - the first one after a reset visits all users')
+  await contracts.harvest.calcscores({ authorization: `${harvest}@active` })
+  await sleep(8000)
 
   console.log('change max limit transactions')
   await contracts.settings.configure('batchsize', 1, { authorization: `${settings}@active` })
@@ -1180,10 +1338,19 @@ describe('bioregions contribution score', async assert => {
     json: true
   })
 
-  const cspointsBiosTemp = await getTableRows({
+  const bioCycleReady = await getTableRows({
     code: harvest,
     scope: harvest,
-    table: 'biocstemp',
+    table: 'sizes',
+    lower_bound: 'bio.cs.rdy',
+    upper_bound: 'bio.cs.rdy',
+    json: true
+  })
+
+  const bioCycle = await getTableRows({
+    code: harvest,
+    scope: bioCycleReady.rows[0].size,
+    table: 'biocycle',
     json: true
   })
 
@@ -1198,12 +1365,32 @@ describe('bioregions contribution score', async assert => {
   })
 
   assert({
-    given: 'cs for bioregions, the table biocstemp',
+    given: 'cs for bioregions, the ranked cycle in biocycle',
     should: 'not have entries',
-    actual: cspointsBiosTemp.rows,
+    actual: bioCycle.rows,
     expected: []
   })
 
+  console.log('run the scoring cycle again')
+  await contracts.harvest.calcscores({ authorization: `${harvest}@active` })
+  await sleep(8000)
+  await contracts.harvest.rankbiocss({ authorization: `${harvest}@active` })
+  await sleep(5000)
+
+  const cspointsBiosAgain = await getTableRows({
+    code: harvest,
+    scope: 'bio',
+    table: 'cspoints',
+    json: true
+  })
+
+  assert({
+    given: 'cs for bioregions, scoring cycle run twice',
+    should: 'not add up the points of both runs',
+    actual: cspointsBiosAgain.rows,
+    expected: cspointsBios.rows
+  })
+
 })
 
 
@@ -2,7 +2,7 @@ const { describe } = require("riteway")
 const { names, getTableRows, isLocal, initContracts, createKeypair } = require("../scripts/helper")
 const eosDevKey = "EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV"
 
-const { firstuser, seconduser, thirduser, history, accounts, organization, token, settings, bioregion } = names
+const { firstuser, seconduser, thirduser, history, accounts, organization, token, settings, bioregion, harvest } = names
 
 function getBeginningOfDayInSeconds () {
   const now = new Date()
@@ -444,6 +444,20 @@ describe('individual transactions', async assert => {
     ]
   })
 
+  const trxPointsWindow = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxptwindow',
+    json: true
+  })
+
+  assert({
+    given: 'transaction made',
+    should: 'keep the running sum of trx points in the window',
+    actual: [firstuser, seconduser, thirduser].map(user => trxPointsWindow.rows.find(r => r.account == user).points),
+    expected: [412, 1120, 1]
+  })
+
   assert({
     given: 'transactions made',
     should: 'have the correct entries in qevs tables',
@@ -905,4 +919,74 @@ describe('individual transactions', async assert => {
     ]
   })
 
-})
\ No newline at end of file
+})
+describe('transaction entries in the same second', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+  const contracts = await initContracts({ history, accounts, settings, harvest })
+
+  const day = getBeginningOfDayInSeconds()
+
+  console.log('settings reset')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('history reset')
+  await contracts.history.reset(firstuser, { authorization: `${history}@active` })
+  await contracts.history.reset(seconduser, { authorization: `${history}@active` })
+  await contracts.history.deldailytrx(day, { authorization: `${history}@active` })
+
+  console.log('harvest reset')
+  await contracts.harvest.reset({ authorization: `${harvest}@active` })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  await contracts.accounts.adduser(firstuser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.testsetrs(seconduser, 49, { authorization: `${accounts}@active` })
+
+  console.log('two transaction entries without waiting')
+  await contracts.history.trxentry(firstuser, seconduser, '10.0000 SEEDS', { authorization: `${history}@active` })
+  await contracts.history.trxentry(firstuser, seconduser, '20.0000 SEEDS', { authorization: `${history}@active` })
+
+  const dailyTrx = await getTableRows({
+    code: history,
+    scope: day,
+    table: 'dailytrxs',
+    json: true
+  })
+
+  const trxPoints = await getTableRows({
+    code: history,
+    scope: firstuser,
+    table: 'trxpoints',
+    json: true
+  })
+
+  const txPoints = await getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'txpoints',
+    json: true
+  })
+
+  const expectedPoints = dailyTrx.rows.reduce((sum, { from_points }) => sum + from_points, 0)
+
+  assert({
+    given: 'two entries in the same second',
+    should: 'record the points of both',
+    actual: trxPoints.rows.map(({ points }) => points),
+    expected: [expectedPoints]
+  })
+
+  assert({
+    given: 'two entries in the same second',
+    should: 'update harvest tx points in the same transaction',
+    actual: txPoints.rows.map(({ account, points }) => ({ account, points })),
+    expected: [{ account: firstuser, points: expectedPoints }]
+  })
+
+})
@@ -99,7 +99,7 @@ describe('Invites', async assert => {
   const harvestClaimed = await getTableRows({
     code: harvest,
     scope: harvest,
-    table: 'balances',
+    table: 'planted',
     json: true
   })
 
@@ -152,11 +152,10 @@ describe('Invites', async assert => {
   assert({
     given: 'planted balance after claimed',
     should: 'be positive amount',
-    actual: harvestClaimed.rows.find(user => user.account == inviteduser),
+    actual: harvestClaimed.rows.filter(user => user.account == inviteduser).map(({ account, planted }) => ({ account, planted }))[0],
     expected: {
       account: inviteduser,
-      planted: '5.0000 SEEDS',
-      reward: '0.0000 SEEDS'
+      planted: '5.0000 SEEDS'
     }
   })
 
@@ -176,7 +175,7 @@ describe('Invites', async assert => {
   const harvestClaimed2 = await getTableRows({
     code: harvest,
     scope: harvest,
-    table: 'balances',
+    table: 'planted',
     json: true
   })
 
@@ -190,11 +189,10 @@ describe('Invites', async assert => {
   assert({
     given: 'planted balance after 2nd claimed',
     should: 'be positive amount',
-    actual: harvestClaimed2.rows.find(user => user.account == inviteduser),
+    actual: harvestClaimed2.rows.filter(user => user.account == inviteduser).map(({ account, planted }) => ({ account, planted }))[0],
     expected: {
       account: inviteduser,
-      planted: '10.0000 SEEDS',
-      reward: '0.0000 SEEDS'
+      planted: '10.0000 SEEDS'
     }
   })
 
@@ -69,3 +69,54 @@ describe('settings', async assert => {
 
 
 })
+
+describe('config snapshot', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contract = await eos.contract(settings)
+
+  await contract.reset({ authorization: `${settings}@active` })
+
+  const getRows = async table => (await eos.getTableRows({
+    code: settings,
+    scope: settings,
+    table,
+    limit: 1000,
+    json: true
+  })).rows
+
+  const config = await getRows('config')
+  const snapshot = await getRows('cfgsnap')
+  const configFloat = await getRows('configfloat')
+  const snapshotFloat = await getRows('cfgfltsnap')
+
+  await contract.configure("testing", 78, { authorization: `${settings}@active` })
+
+  const testing = (await getRows('cfgsnap')).filter(({ param }) => param == "testing")[0]
+
+  assert({
+    given: 'reset settings',
+    should: 'have a snapshot of every config value',
+    actual: snapshot.map(({ param, value }) => ({ param, value })),
+    expected: config.map(({ param, value }) => ({ param, value }))
+  })
+
+  assert({
+    given: 'reset settings',
+    should: 'have a snapshot of every float config value',
+    actual: snapshotFloat.map(({ param, value }) => ({ param, value: Number(value) })),
+    expected: configFloat.map(({ param, value }) => ({ param, value: Number(value) }))
+  })
+
+  assert({
+    given: 'configure a value',
+    should: 'update the snapshot',
+    actual: testing.value,
+    expected: 78
+  })
+
+})
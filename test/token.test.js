@@ -188,6 +188,57 @@ describe('token.transfer', async assert => {
   })
 })
 
+describe('token.transfermany', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ token, accounts, harvest })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(firstuser, '', 'individual', { authorization: `${accounts}@active` })
+
+  console.log('plant SEEDS')
+  await contracts.token.transfer(firstuser, harvest, '10.0000 SEEDS', '', { authorization: `${firstuser}@active` })
+
+  const balancesBefore = await Promise.all([harvest, seconduser, thirduser].map(getBalance))
+
+  console.log('pay out from harvest')
+  await contracts.token.transfermany(harvest, [
+    { to: seconduser, quantity: '5.0000 SEEDS' },
+    { to: thirduser, quantity: '3.0000 SEEDS' },
+    { to: seconduser, quantity: '2.0000 SEEDS' }
+  ], 'payout', { authorization: `${harvest}@active` })
+
+  const balancesAfter = await Promise.all([harvest, seconduser, thirduser].map(getBalance))
+
+  let userFailed = false
+  try {
+    await contracts.token.transfermany(firstuser, [
+      { to: seconduser, quantity: '1.0000 SEEDS' }
+    ], '', { authorization: `${firstuser}@active` })
+  } catch (err) {
+    userFailed = true
+  }
+
+  assert({
+    given: 'transfermany called',
+    should: 'debit the sender once and credit every recipient',
+    actual: balancesAfter.map((b, i) => b - balancesBefore[i]),
+    expected: [-10, 7, 3]
+  })
+
+  assert({
+    given: 'transfermany called by a user',
+    should: 'fail',
+    actual: userFailed,
+    expected: true
+  })
+})
+
 describe('token.burn', async assert => {
 
   if (!isLocal()) {